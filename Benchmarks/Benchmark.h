@@ -0,0 +1,283 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// Benchmark.h - small timing harness built on DateTime            //
+// ver 1.1                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+*  Package Operations:
+*  -------------------
+*  This package provides the Benchmark class, a suite of named timing
+*  cases.  Each case is a callable that does one unit of work and
+*  returns the number of items it processed, e.g., files listed or
+*  bytes read.  run() executes each case for a few warmup passes and
+*  then a number of timed repetitions, timed with DateTime::start/stop,
+*  and reports min, median, mean, and max times and item throughput.
+*
+*  Results can be written to and read from CSV files.  compare() checks
+*  a run against a saved baseline and reports every case whose median
+*  time grew by more than a tolerance, so a saved run can gate
+*  regressions.
+*
+*  Public Interface:
+*  -----------------
+*  Benchmark bench("FileSystem");
+*  bench.add("getFiles", [&]() { return Directory::getFiles(path).size(); });
+*  bench.repetitions(10);
+*  Benchmark::Results results = bench.run();
+*  Benchmark::writeCsv(results, csvStream);
+*  bool ok = Benchmark::compare(Benchmark::readCsv(baseStream), results, 0.10);
+*
+*  Required Files:
+*  ---------------
+*  Benchmark.h
+*  DateTime.h, DateTime.cpp
+*
+*  Maintenance History:
+*  --------------------
+*  ver 1.1 : 19 Oct 2026
+*  - readCsv skips lines whose numbers don't parse instead of throwing
+*  ver 1.0 : 19 Oct 2026
+*  - first release
+*/
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <regex>
+#include <stdexcept>
+#include "../DateTime/DateTime.h"
+
+namespace Utilities
+{
+  ///////////////////////////////////////////////////////////////////
+  // BenchResult - timing statistics for one benchmark case
+
+  struct BenchResult
+  {
+    std::string name;
+    size_t repetitions = 0;
+    size_t items = 0;        // items processed per repetition
+    double minMs = 0.0;
+    double medianMs = 0.0;
+    double meanMs = 0.0;
+    double maxMs = 0.0;
+
+    double itemsPerSecond() const
+    {
+      return medianMs > 0.0 ? 1000.0 * items / medianMs : 0.0;
+    }
+  };
+
+  ///////////////////////////////////////////////////////////////////
+  // Benchmark class
+  // - holds named cases and runs them in the order they were added
+
+  class Benchmark
+  {
+  public:
+    using Body = std::function<size_t()>;  // returns items processed
+    using Results = std::vector<BenchResult>;
+
+    Benchmark(const std::string& suiteName = "benchmarks") : suite_(suiteName) {}
+
+    void add(const std::string& name, Body body);
+    void repetitions(size_t reps);
+    void warmups(size_t passes);
+    void filter(const std::string& regex);
+    Results run(std::ostream& out = std::cout);
+
+    static void show(const Results& results, std::ostream& out = std::cout);
+    static void writeCsv(const Results& results, std::ostream& out);
+    static Results readCsv(std::istream& in);
+    static bool compare(
+      const Results& baseline, const Results& current,
+      double tolerance = 0.10, std::ostream& out = std::cout
+    );
+  private:
+    struct Case
+    {
+      std::string name;
+      Body body;
+    };
+    std::string suite_;
+    std::vector<Case> cases_;
+    size_t reps_ = 5;
+    size_t warmups_ = 1;
+    std::string filter_ = ".*";
+  };
+
+  //----< add a named case >-----------------------------------------
+
+  inline void Benchmark::add(const std::string& name, Body body)
+  {
+    cases_.push_back(Case{ suite_ + "/" + name, body });
+  }
+  //----< set number of timed repetitions, at least one >------------
+
+  inline void Benchmark::repetitions(size_t reps)
+  {
+    reps_ = reps > 0 ? reps : 1;
+  }
+  //----< set number of untimed passes before timing >---------------
+
+  inline void Benchmark::warmups(size_t passes)
+  {
+    warmups_ = passes;
+  }
+  //----< run only cases whose names match regex >-------------------
+
+  inline void Benchmark::filter(const std::string& regex)
+  {
+    filter_ = regex;
+  }
+  //----< time each case, returning statistics >---------------------
+
+  inline Benchmark::Results Benchmark::run(std::ostream& out)
+  {
+    Results results;
+    std::regex rgx(filter_);
+    for (auto& benchCase : cases_)
+    {
+      if (!std::regex_search(benchCase.name, rgx))
+        continue;
+      out << "\n  running " << benchCase.name << std::flush;
+
+      for (size_t i = 0; i < warmups_; ++i)
+        benchCase.body();
+
+      std::vector<double> times;
+      BenchResult result;
+      result.name = benchCase.name;
+      result.repetitions = reps_;
+      DateTime timer;
+      for (size_t i = 0; i < reps_; ++i)
+      {
+        timer.start();
+        result.items = benchCase.body();
+        timer.stop();
+        times.push_back(timer.elapsedMicroseconds() / 1000.0);
+      }
+      std::sort(times.begin(), times.end());
+      result.minMs = times.front();
+      result.maxMs = times.back();
+      size_t mid = times.size() / 2;
+      result.medianMs = times.size() % 2 ? times[mid] : (times[mid - 1] + times[mid]) / 2.0;
+      double sum = 0.0;
+      for (double t : times)
+        sum += t;
+      result.meanMs = sum / times.size();
+      results.push_back(result);
+    }
+    return results;
+  }
+  //----< display results as a table >-------------------------------
+
+  inline void Benchmark::show(const Results& results, std::ostream& out)
+  {
+    out << "\n\n  " << std::left << std::setw(40) << "benchmark" << std::right
+      << std::setw(11) << "min ms" << std::setw(11) << "median ms"
+      << std::setw(11) << "max ms" << std::setw(15) << "items/sec";
+    out << "\n  " << std::string(88, '-');
+    out << std::fixed << std::setprecision(3);
+    for (auto& result : results)
+    {
+      out << "\n  " << std::left << std::setw(40) << result.name << std::right
+        << std::setw(11) << result.minMs << std::setw(11) << result.medianMs
+        << std::setw(11) << result.maxMs
+        << std::setw(15) << std::setprecision(0) << result.itemsPerSecond()
+        << std::setprecision(3);
+    }
+    out.unsetf(std::ios::fixed);
+    out << std::setprecision(6);
+  }
+  //----< write results, one case per line >-------------------------
+
+  inline void Benchmark::writeCsv(const Results& results, std::ostream& out)
+  {
+    out << std::setprecision(9);
+    out << "name,repetitions,items,minMs,medianMs,meanMs,maxMs\n";
+    for (auto& result : results)
+    {
+      out << result.name << "," << result.repetitions << "," << result.items << ","
+        << result.minMs << "," << result.medianMs << ","
+        << result.meanMs << "," << result.maxMs << "\n";
+    }
+  }
+  //----< read results written by writeCsv >-------------------------
+  /*
+  *  Lines without seven fields, or whose numbers don't parse, e.g.,
+  *  from a hand edited or truncated file, are skipped, so their cases
+  *  are missing from the baseline rather than ending the run.
+  */
+
+  inline Benchmark::Results Benchmark::readCsv(std::istream& in)
+  {
+    Results results;
+    std::string line;
+    std::getline(in, line);  // header
+    while (std::getline(in, line))
+    {
+      std::vector<std::string> fields;
+      std::istringstream fieldStrm(line);
+      std::string field;
+      while (std::getline(fieldStrm, field, ','))
+        fields.push_back(field);
+      if (fields.size() != 7)
+        continue;
+      BenchResult result;
+      result.name = fields[0];
+      try
+      {
+        result.repetitions = std::stoul(fields[1]);
+        result.items = std::stoul(fields[2]);
+        result.minMs = std::stod(fields[3]);
+        result.medianMs = std::stod(fields[4]);
+        result.meanMs = std::stod(fields[5]);
+        result.maxMs = std::stod(fields[6]);
+      }
+      catch (std::exception&)  // invalid_argument or out_of_range
+      {
+        continue;
+      }
+      results.push_back(result);
+    }
+    return results;
+  }
+  //----< report cases whose median grew by more than tolerance >----
+  /*
+  *  Cases missing from either set of results are ignored.  Returns
+  *  false if any case regressed.
+  */
+  inline bool Benchmark::compare(
+    const Results& baseline, const Results& current, double tolerance, std::ostream& out
+  )
+  {
+    bool passed = true;
+    out << std::fixed << std::setprecision(3);
+    for (auto& curr : current)
+    {
+      auto iter = std::find_if(baseline.begin(), baseline.end(),
+        [&curr](const BenchResult& base) { return base.name == curr.name; });
+      if (iter == baseline.end() || iter->medianMs <= 0.0)
+        continue;
+      double ratio = curr.medianMs / iter->medianMs;
+      if (ratio > 1.0 + tolerance)
+      {
+        passed = false;
+        out << "\n  regression: " << curr.name << " median " << iter->medianMs
+          << " ms -> " << curr.medianMs << " ms (x" << ratio << ")";
+      }
+    }
+    out.unsetf(std::ios::fixed);
+    out << std::setprecision(6);
+    return passed;
+  }
+}
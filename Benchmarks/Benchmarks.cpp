@@ -0,0 +1,444 @@
+///////////////////////////////////////////////////////////////////////
+// Benchmarks.cpp - times FileSystem, explorer, Logger, and string   //
+//                  operations on a synthetic directory tree         //
+// ver 1.5                                                           //
+//-------------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                    //
+// All rights granted provided this copyright notice is retained     //
+//-------------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University     //
+///////////////////////////////////////////////////////////////////////
+/*
+*  Package Operations:
+*  -------------------
+*  Builds a synthetic tree with TreeGenerator, then times:
+*  - Directory::getFiles, returning strings and filling a NameArena
+*  - Path::getFullFileSpec and PathResolver on every directory
+*  - DirExplorerT and DirExplorerE walks of the whole tree
+*  - File::getLine, File::readAll, and File::getBuffer on a large file
+*  - Logger::write throughput from several threads
+*  - trim and split
+*  - Path::toLower, and CaseFold's in place conversion
+*  - Path::getName and getExt, and PathView, on every file
+*  - PersistFactory::toXml building strings, and writing to XmlWriter
+*  Run a Release build.  Save a run with /F and gate a later run
+*  against it with /B.
+*
+*  Required Files:
+*  ---------------
+*  Benchmarks.cpp, Benchmark.h, TreeGenerator.h
+*  DirExplorerT.h, DirExplorerE.h
+*  FileSystem.h, FileSystem.cpp, NameArena.h, PathResolver.h, PathView.h
+*  SingletonLogger.h, ISingletonLogger.h
+*  StringUtilities.h, CodeUtilities.h
+*  DateTime.h, DateTime.cpp
+*
+*  Maintenance History:
+*  --------------------
+*  ver 1.5 : 19 Oct 2026
+*  - cleanup deletes only the generated files and directories, never
+*    other contents of a /P directory, nor the directory if it existed
+*  ver 1.4 : 19 Oct 2026
+*  - added path decomposition cases
+*  ver 1.3 : 19 Oct 2026
+*  - added case folding cases
+*  ver 1.2 : 19 Oct 2026
+*  - added path resolution cases
+*  ver 1.1 : 19 Oct 2026
+*  - added serialization cases
+*  ver 1.0 : 19 Oct 2026
+*  - first release
+*/
+
+#ifdef TEST_BENCHMARKS  // only compile the following when defined
+
+#include "Benchmark.h"
+#include "TreeGenerator.h"
+#include "../FileSystem/FileSystem.h"
+#include "../FileSystem/NameArena.h"
+#include "../FileSystem/PathResolver.h"
+#include "../DirExplorer-Template/DirExplorerT.h"
+#include "../DirExplorer-Events/DirExplorerE.h"
+#include "../SingletonLogger/SingletonLogger.h"
+#include "../StringUtilities/StringUtilities.h"
+#include "../CodeUtilities/CodeUtilities.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+
+using namespace Utilities;
+using namespace FileSystem;
+
+/////////////////////////////////////////////////////////////////////
+// CountApp - minimal DirExplorerT application, so walks time the
+//            explorer rather than the application
+
+class CountApp
+{
+public:
+  void doFile(const std::string& filename) { ++fileCount_; }
+  void doDir(const std::string& dirname) { ++dirCount_; }
+  size_t fileCount() { return fileCount_; }
+  size_t dirCount() { return dirCount_; }
+  bool done() { return false; }
+  void showStats() {}
+  void showAllInCurrDir(bool showAll) {}
+  bool showAllInCurrDir() { return false; }
+  void maxItems(size_t maxItems) {}
+private:
+  size_t fileCount_ = 0;
+  size_t dirCount_ = 0;
+};
+
+/////////////////////////////////////////////////////////////////////
+// CountFileEvent - minimal DirExplorerE file handler
+
+class CountFileEvent : public IFileEvent
+{
+public:
+  CountFileEvent(size_t& count) : count_(count) {}
+  void execute(const std::string& filename) override { ++count_; }
+private:
+  size_t& count_;
+};
+
+//----< collect every directory of tree, for per-directory cases >---
+
+std::vector<std::string> allDirectories(const std::string& root)
+{
+  std::vector<std::string> dirs{ root };
+  for (size_t i = 0; i < dirs.size(); ++i)
+  {
+    for (auto& dir : Directory::getDirectories(dirs[i]))
+    {
+      if (dir != "." && dir != "..")
+        dirs.push_back(Path::fileSpec(dirs[i], dir));
+    }
+  }
+  return dirs;
+}
+//----< full path of every file in dirs >----------------------------
+
+std::vector<std::string> allFiles(const std::vector<std::string>& dirs)
+{
+  std::vector<std::string> paths;
+  for (auto& dir : dirs)
+  {
+    for (auto& file : Directory::getFiles(dir))
+      paths.push_back(Path::fileSpec(dir, file));
+  }
+  return paths;
+}
+
+void addFileSystemCases(Benchmark& bench, const std::vector<std::string>& dirs)
+{
+  bench.add("getFiles/strings", [&dirs]() {
+    size_t count = 0;
+    for (auto& dir : dirs)
+      count += Directory::getFiles(dir).size();
+    return count;
+  });
+  bench.add("getFiles/arena", [&dirs]() {
+    NameArena names;
+    size_t count = 0;
+    for (auto& dir : dirs)
+    {
+      names.reset();
+      count += Directory::getFiles(dir, "*.*", names);
+    }
+    return count;
+  });
+  bench.add("getFullFileSpec", [&dirs]() {
+    size_t chars = 0;
+    for (auto& dir : dirs)
+      chars += Path::getFullFileSpec(dir).size();
+    return chars;
+  });
+  bench.add("PathResolver", [&dirs]() {
+    PathResolver resolver;
+    size_t chars = 0;
+    for (auto& dir : dirs)
+      chars += resolver.resolve(dir).size();
+    return chars;
+  });
+}
+
+void addExplorerCases(Benchmark& bench, const std::string& root)
+{
+  bench.add("DirExplorerT", [root]() {
+    DirExplorerT<CountApp> de(root);
+    de.recurse();
+    de.search();
+    return de.fileCount();
+  });
+  bench.add("DirExplorerE", [root]() {
+    size_t count = 0;
+    DirExplorerE de(root);
+    de.fileSubScribe(new CountFileEvent(count));
+    de.recurse();
+    de.search();
+    return count;
+  });
+}
+
+void addFileCases(Benchmark& bench, const std::string& fileSpec, size_t fileBytes)
+{
+  bench.add("File::getLine", [fileSpec]() {
+    File file(fileSpec);
+    file.open(File::in);
+    size_t lines = 0;
+    while (file.isGood())
+    {
+      file.getLine();
+      ++lines;
+    }
+    return lines;
+  });
+  bench.add("File::readAll", [fileSpec]() {
+    File file(fileSpec);
+    file.open(File::in);
+    return file.readAll(true).size();
+  });
+  bench.add("File::getBuffer", [fileSpec]() {
+    File file(fileSpec);
+    file.open(File::in, File::binary);
+    std::vector<File::byte> buffer(64 * 1024);
+    size_t bytes = 0;
+    while (file.isGood())
+    {
+      size_t count = file.getBuffer(buffer.size(), buffer.data());
+      if (count == 0)
+        break;
+      bytes += count;
+    }
+    return bytes;
+  });
+}
+//----< Logger::write from numThreads threads >-----------------------
+/*
+*  Logger::write does not lock, so writers share a mutex, as callers
+*  must today.  The sink is an ostringstream, so the case times the
+*  logger, not the console.
+*/
+void addLoggerCases(Benchmark& bench, size_t numThreads, size_t writesPerThread)
+{
+  using BenchLogger = Logger<7, Lock>;
+  bench.add("Logger::write/" + std::to_string(numThreads) + "threads", [=]() {
+    std::ostringstream sink;
+    BenchLogger* pLogger = BenchLogger::getInstance();
+    pLogger->removeStream(&std::cout);
+    pLogger->addStream(&sink);
+    std::mutex mtx;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      threads.push_back(std::thread([=, &mtx]() {
+        std::string msg = "thread " + std::to_string(t) + " writes a log entry";
+        for (size_t i = 0; i < writesPerThread; ++i)
+        {
+          std::lock_guard<std::mutex> lock(mtx);
+          pLogger->write(msg);
+        }
+      }));
+    }
+    for (auto& thrd : threads)
+      thrd.join();
+    pLogger->removeStream(&sink);
+    return numThreads * writesPerThread;
+  });
+}
+
+void addStringCases(Benchmark& bench, size_t numStrings)
+{
+  std::vector<std::string> padded, lists;
+  for (size_t i = 0; i < numStrings; ++i)
+  {
+    padded.push_back("  \t value " + std::to_string(i) + " \n ");
+    lists.push_back("alpha, beta ,gamma," + std::to_string(i) + ", delta , epsilon");
+  }
+  bench.add("trim", [padded]() {
+    size_t chars = 0;
+    for (auto& str : padded)
+      chars += trim(str).size();
+    return chars;  // chars kept, so the trims can't be optimized away
+  });
+  bench.add("split", [lists]() {
+    size_t splits = 0;
+    for (auto& str : lists)
+      splits += split(str).size();
+    return splits;
+  });
+}
+
+void addCaseCases(Benchmark& bench, const std::vector<std::string>& paths)
+{
+  bench.add("Path::toLower", [paths]() {
+    size_t chars = 0;
+    for (auto& path : paths)
+      chars += Path::toLower(path).size();
+    return chars;
+  });
+  bench.add("toLowerInPlace", [folded = paths]() mutable {
+    size_t chars = 0;
+    for (auto& path : folded)
+    {
+      toLowerInPlace(path);
+      chars += path.size();
+    }
+    return chars;
+  });
+}
+//----< classify files by stem and extension, as explorer apps do >--
+
+void addPathViewCases(Benchmark& bench, const std::vector<std::string>& paths)
+{
+  bench.add("Path::getName+getExt", [&paths]() {
+    size_t matches = 0;
+    for (auto& path : paths)
+    {
+      if (Path::getExt(path) == "txt" && Path::getName(path, false).size() > 4)
+        ++matches;
+    }
+    return matches;
+  });
+  bench.add("PathView", [&paths]() {
+    size_t matches = 0;
+    for (auto& path : paths)
+    {
+      PathView view(path);
+      if (view.ext().equalsNoCase("txt") && view.stem().size() > 4)
+        ++matches;
+    }
+    return matches;
+  });
+}
+
+void addSerializeCases(Benchmark& bench, size_t numRecords)
+{
+  std::vector<PersistFactory<std::string>> names;
+  for (size_t i = 0; i < numRecords; ++i)
+    names.push_back(std::string("part & assembly ") + std::to_string(i));
+  bench.add("toXml/strings", [names]() mutable {
+    std::string doc;
+    for (auto& name : names)
+      doc += name.toXml("name");
+    return doc.size();
+  });
+  bench.add("toXml/XmlWriter", [names]() mutable {
+    XmlWriter writer;
+    for (auto& name : names)
+      name.toXml(writer, "name");
+    return writer.bytesWritten();
+  });
+}
+
+std::string customUsage()
+{
+  std::string usage;
+  usage += "\n  Command Line: [/option arg]* [/option]*";
+  usage += "\n    /P path    - where synthetic tree is built, default ./BenchTree";
+  usage += "\n    /n number  - timed repetitions of each case, default 5";
+  usage += "\n    /d number  - tree depth, default 2";
+  usage += "\n    /w number  - subdirectories per directory, default 4";
+  usage += "\n    /f number  - files per directory, default 50";
+  usage += "\n    /t number  - Logger threads, default 4";
+  usage += "\n    /R regex   - run only matching cases";
+  usage += "\n    /F file    - save results as CSV";
+  usage += "\n    /B file    - compare with CSV baseline, fail on >10% slowdown";
+  usage += "\n    /k         - keep synthetic tree after run";
+  usage += "\n  Only the generated file<N>.txt, dir<N>, and big.txt are removed,";
+  usage += "\n  and the /P directory itself only if the run created it";
+  usage += "\n";
+  return usage;
+}
+
+int main(int argc, char *argv[])
+{
+  Title("Benchmarks for FileSystem, explorers, Logger, and strings");
+
+  ProcessCmdLine pcl(argc, argv);
+  pcl.usage(customUsage());
+  for (char opt : { 'd', 'w', 'f', 't' })
+    pcl.declareOption(opt, OptionType::number);
+  pcl.declareOption('B', OptionType::text);
+  pcl.declareOption('k', OptionType::flag);
+  pcl.process();
+
+  if (pcl.parseError())
+  {
+    pcl.showErrors();
+    pcl.usage();
+    std::cout << "\n\n";
+    return 1;
+  }
+
+  std::string root = pcl.hasOption('P') ? pcl.path() : "./BenchTree";
+  TreeShape shape;
+  shape.depth = (size_t)pcl.number('d', (long)shape.depth);
+  shape.fanout = (size_t)pcl.number('w', (long)shape.fanout);
+  shape.filesPerDir = (size_t)pcl.number('f', (long)shape.filesPerDir);
+
+  title("building synthetic tree at " + root);
+  bool rootExisted = Directory::exists(root);
+  size_t numFiles = makeTree(root, shape);
+  std::string bigFile = Path::fileSpec(root, "big.txt");
+  size_t bigBytes = 16 * 1024 * 1024;
+  makeFile(bigFile, bigBytes);
+  std::cout << "\n  created " << numFiles << " files and a " << bigBytes << " byte file";
+  std::vector<std::string> dirs = allDirectories(root);
+
+  Benchmark bench("bench");
+  bench.repetitions((size_t)pcl.number('n', 5));
+  if (pcl.hasOption('R'))
+    bench.filter(pcl.regex());
+
+  addFileSystemCases(bench, dirs);
+  addExplorerCases(bench, root);
+  addFileCases(bench, bigFile, bigBytes);
+  addLoggerCases(bench, (size_t)pcl.number('t', 4), 20000);
+  addStringCases(bench, 100000);
+  std::vector<std::string> files = allFiles(dirs);
+  addCaseCases(bench, files);
+  addPathViewCases(bench, files);
+  addSerializeCases(bench, 100000);
+
+  Benchmark::Results results = bench.run();
+  Benchmark::show(results);
+
+  if (pcl.hasOption('F'))
+  {
+    std::ofstream csv(pcl.logFile());
+    Benchmark::writeCsv(results, csv);
+    std::cout << "\n\n  saved results to " << pcl.logFile();
+  }
+
+  bool passed = true;
+  if (pcl.hasOption('B'))
+  {
+    std::ifstream csv(pcl.value('B'));
+    if (!csv.good())
+    {
+      std::cout << "\n\n  can't open baseline " << pcl.value('B');
+      passed = false;
+    }
+    else
+    {
+      title("comparing with baseline " + pcl.value('B'));
+      passed = Benchmark::compare(Benchmark::readCsv(csv), results);
+      std::cout << "\n  " << (passed ? "no regressions" : "regressions found");
+    }
+  }
+
+  if (!pcl.hasOption('k'))
+  {
+    File::remove(bigFile);
+    removeTree(root, shape, !rootExisted);
+  }
+
+  std::cout << "\n\n";
+  return passed ? 0 : 1;
+}
+
+#endif
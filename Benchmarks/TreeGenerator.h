@@ -0,0 +1,128 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// TreeGenerator.h - builds synthetic directory trees for timing   //
+// ver 1.1                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+*  Package Operations:
+*  -------------------
+*  makeTree(root, shape) creates a directory tree under root whose
+*  shape is described by TreeShape: depth levels of subdirectories,
+*  fanout subdirectories per directory, and filesPerDir text files
+*  in every directory, each about fileBytes long.  Files hold numbered
+*  lines, so they exercise line oriented reads as well as block reads.
+*  removeTree(root, shape) deletes the files and directories that
+*  makeTree(root, shape) creates, and nothing else, so a tree built
+*  inside a directory holding other data leaves that data in place.
+*  Directories are removed only once they are empty, and root only
+*  when removeRoot is true.
+*
+*  Public Interface:
+*  -----------------
+*  TreeShape shape;
+*  shape.depth = 3; shape.fanout = 4; shape.filesPerDir = 50;
+*  size_t numFiles = makeTree("./BenchTree", shape);
+*  ...
+*  removeTree("./BenchTree", shape);
+*
+*  Required Files:
+*  ---------------
+*  TreeGenerator.h
+*  FileSystem.h, FileSystem.cpp
+*
+*  Maintenance History:
+*  --------------------
+*  ver 1.1 : 19 Oct 2026
+*  - removeTree takes the shape and deletes only the names makeTree
+*    creates, rather than everything under root
+*  ver 1.0 : 19 Oct 2026
+*  - first release
+*/
+#include <fstream>
+#include <string>
+#include "../FileSystem/FileSystem.h"
+
+namespace FileSystem
+{
+  struct TreeShape
+  {
+    size_t depth = 2;          // levels of subdirectories below root
+    size_t fanout = 4;         // subdirectories per directory
+    size_t filesPerDir = 50;
+    size_t fileBytes = 4096;   // approximate size of each file
+  };
+
+  //----< write a file of numbered lines, about numBytes long >------
+
+  inline bool makeFile(const std::string& fileSpec, size_t numBytes)
+  {
+    std::ofstream out(fileSpec, std::ios::binary);
+    if (!out.good())
+      return false;
+    size_t written = 0;
+    for (size_t lineNum = 0; written < numBytes; ++lineNum)
+    {
+      std::string line = "synthetic line " + std::to_string(lineNum) + " of benchmark data\n";
+      out << line;
+      written += line.size();
+    }
+    return out.good();
+  }
+  //----< create tree of directories and files, return file count >--
+
+  inline size_t makeTree(const std::string& root, const TreeShape& shape)
+  {
+    Directory::create(root);  // may already exist
+    size_t count = 0;
+    for (size_t i = 0; i < shape.filesPerDir; ++i)
+    {
+      if (makeFile(Path::fileSpec(root, "file" + std::to_string(i) + ".txt"), shape.fileBytes))
+        ++count;
+    }
+    if (shape.depth == 0)
+      return count;
+    TreeShape subShape = shape;
+    --subShape.depth;
+    for (size_t i = 0; i < shape.fanout; ++i)
+      count += makeTree(Path::fileSpec(root, "dir" + std::to_string(i)), subShape);
+    return count;
+  }
+  //----< true if path holds no files or subdirectories >-----------
+
+  inline bool isEmptyDirectory(const std::string& path)
+  {
+    if (!Directory::getFiles(path).empty())
+      return false;
+    for (auto& dir : Directory::getDirectories(path))
+    {
+      if (dir != "." && dir != "..")
+        return false;
+    }
+    return true;
+  }
+  //----< delete only what makeTree(root, shape) created >-----------
+
+  inline void removeTree(const std::string& root, const TreeShape& shape, bool removeRoot = true)
+  {
+    for (size_t i = 0; i < shape.filesPerDir; ++i)
+      File::remove(Path::fileSpec(root, "file" + std::to_string(i) + ".txt"));
+    if (shape.depth > 0)
+    {
+      TreeShape subShape = shape;
+      --subShape.depth;
+      for (size_t i = 0; i < shape.fanout; ++i)
+      {
+        std::string dir = Path::fileSpec(root, "dir" + std::to_string(i));
+        if (Directory::exists(dir))
+          removeTree(dir, subShape);
+      }
+    }
+    if (removeRoot && isEmptyDirectory(root))
+      Directory::remove(root);
+  }
+}
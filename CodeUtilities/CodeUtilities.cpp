@@ -1,6 +1,6 @@
 /////////////////////////////////////////////////////////////////////
 // CodeUtilities.cpp - small, generally useful, helper classes     //
-// ver 1.7                                                         //
+// ver 2.2                                                         //
 //-----------------------------------------------------------------//
 // Jim Fawcett (c) copyright 2019                                  //
 // All rights granted provided this copyright notice is retained   //
@@ -66,6 +66,17 @@ int main(int argc, char* argv[])
   pcl.showParse();
   putline();
 
+  title("Testing typed options");
+  char* typedArgs[] = { (char*)"prog", (char*)"/d", (char*)"3", (char*)"/n", (char*)"12x", (char*)"/s", (char*)"oops" };
+  ProcessCmdLine typed(7, typedArgs);
+  typed.declareOption('d', OptionType::number);
+  typed.process();
+  preface("depth:    "); std::cout << typed.number('d', 1);
+  preface("maxItems: "); std::cout << typed.maxItems();
+  preface("parse error: "); std::cout << std::boolalpha << typed.parseError();
+  typed.showErrors();
+  putline();
+
   title("Testing Box and PersistFactory");
   Box<double> boxedDouble = 3.1415927;
   std::cout << "\n  boxedDouble = " << boxedDouble;
@@ -82,6 +93,53 @@ int main(int argc, char* argv[])
   std::cout << "\n  " << value.toXml("value");
   std::cout << "\n\n";
 
+  title("Testing XmlWriter and JsonWriter");
+  XmlWriter xml;
+  JsonWriter json;
+  for (DocWriter* pWriter : std::vector<DocWriter*>{ &xml, &json })
+  {
+    DocWriter& writer = *pWriter;
+    name.toXml(writer, "name");
+    value.toXml(writer, "value");
+    writer.beginArray("parts");
+    for (int i = 0; i < 3; ++i)
+    {
+      writer.beginObject("part");
+      writer.field("id", i);
+      writer.field("label", "bolt <M" + std::to_string(i + 4) + "> \"zinc\"");
+      writer.field("inStock", i % 2 == 0);
+      writer.endObject("part");
+    }
+    writer.endArray("parts");
+    writer.finish();
+  }
+  std::cout << "\n  " << xml.str();
+  std::cout << "\n  " << json.str();
+  std::cout << "\n\n";
+
+  title("Testing XmlReader and PersistFactory::fromXml");
+  std::string doc = "<?xml version=\"1.0\"?>\n<!-- inventory snapshot -->\n" + xml.str();
+  XmlReader reader(doc);
+  PersistFactory<std::string> nameBack;
+  PersistFactory<Box<double>> valueBack;
+  bool ok = nameBack.fromXml(reader, "name") && valueBack.fromXml(reader, "value");
+  std::cout << "\n  read back: " << nameBack << ", " << valueBack << (ok ? "" : " - failed");
+  std::string label;
+  while (reader.next() != XmlReader::endOfDocument && reader.token() != XmlReader::error)
+  {
+    if (reader.token() == XmlReader::startElement && reader.name() == "label")
+    {
+      reader.next();
+      reader.value(label);
+      std::cout << "\n  label at depth " << reader.depth() << ": " << label;
+    }
+  }
+  std::string badDoc = "<parts><part></parts>";
+  XmlReader bad(badDoc);
+  while (bad.next() != XmlReader::error && bad.token() != XmlReader::endOfDocument);
+  std::cout << "\n  malformed: " << bad.errorMsg();
+  std::cout << "\n\n";
+
   title("test std::string Converter<T>::toString(T)");
 
   std::string conv1 = Converter<double>::toString(3.1415927);
@@ -98,6 +156,24 @@ int main(int argc, char* argv[])
   std::cout << Converter<double>::toValue(conv1) << ", ";
   std::cout << Converter<int>::toValue(conv2) << ", ";
   std::cout << Converter<std::string>::toValue(conv3);
+  putline();
+
+  title("test numeric Converters writing into caller's buffer");
+
+  char buffer[32];
+  double values[] = { 0.1, 1.0 / 3.0, -2.5e-300, 6.02214076e23 };
+  for (double val : values)
+  {
+    size_t len = Converter<double>::toString(val, buffer, sizeof(buffer));
+    double back = Converter<double>::toValue(buffer, buffer + len);
+    std::cout << "\n  " << buffer << (back == val ? "  round trips" : "  does not round trip");
+  }
+  size_t len = Converter<long long>::toString(-9223372036854775807LL, buffer, sizeof(buffer));
+  std::cout << "\n  " << buffer << " in " << len << " chars";
+  std::cout << "\n  fits in 4 chars? " << (Converter<int>::toString(123456, buffer, 4) ? "yes" : "no");
+  std::cout << "\n  \"  +42\" reads as " << Converter<int>::toValue("  +42");
+  std::cout << "\n  \"true\" reads as " << Converter<bool>::toValue("true");
+  std::cout << "\n  \"junk\" reads as " << Converter<double>::toValue("junk");
 
   putline(2);
   return 0;
@@ -1,7 +1,7 @@
 #pragma once
 /////////////////////////////////////////////////////////////////////
 // CodeUtilities.h - small, generally useful, helper classes       //
-// ver 1.7                                                         //
+// ver 2.2                                                         //
 //-----------------------------------------------------------------//
 // Jim Fawcett (c) copyright 2019                                  //
 // All rights granted provided this copyright notice is retained   //
@@ -16,6 +16,8 @@
 * - Converter<T>      converts T to and from strings
 * - Box<T>            converts primitive type to instance of a class
 * - PersistFactory<T> adds toXml() method to T
+* - XmlWriter, JsonWriter   stream documents through a reusable buffer
+* - XmlReader         pull parser yielding element and text spans
 *
 * Build Process:
 * --------------
@@ -24,6 +26,48 @@
 *
 * Maintenance History:
 * --------------------
+* ver 2.2 : 19 Oct 2026
+* - JsonWriter writes one line per top level element, newline
+*   delimited JSON, instead of one object whose members could repeat
+* - after /P, the list of roots ends only at an argument that is
+*   exactly /c for a known or declared option c, on the command line
+*   and in @files alike, so POSIX paths like /home/x are roots
+* - an unreadable @file, e.g., a directory, is reported in errors()
+* - XmlReader returns whitespace only text of a leaf element rather
+*   than skipping it
+* - added XmlReader, a pull parser over a caller's buffer, and
+*   PersistFactory<T>::fromXml, which reads back what toXml wrote
+* ver 2.1 : 19 Oct 2026
+* - added DocWriter, with XmlWriter and JsonWriter, which serialize
+*   element by element into one reusable buffer, optionally flushed
+*   to an ostream or file descriptor
+* - added ToXml::toXml(writer, tag) and PersistFactory<T>::toXml(writer, tag)
+* - Box<T> converts to const T& from a const Box
+* ver 2.0 : 19 Oct 2026
+* - Converter<T> for the arithmetic types and bool no longer builds a
+*   stream.  It uses std::to_chars and std::from_chars when compiled
+*   as C++17, and snprintf and strtold otherwise.
+* - added toString(t, buffer, size) and toValue(first, last) overloads
+*   that work in a caller's buffer without allocating
+* - floating point values are now written in the shortest form that
+*   reads back exactly, rather than with the stream's 6 digits
+* ver 1.9 : 19 Oct 2026
+* - ProcessCmdLine expands @responsefile arguments, one argument per
+*   line, read with a single bulk read into a buffer that the argument
+*   list points into, so no string is built per argument
+* - /P may be repeated, or followed by several paths, to give a list of
+*   roots, available from roots()
+* - values following an option, up to the next option, no longer pick
+*   up an option name from the preceding value
+* ver 1.8 : 19 Oct 2026
+* - ProcessCmdLine stores options in a flat 128 slot table, typed by
+*   an OptionType schema, defaultOptionType, that declareOption can
+*   extend.  Arguments are checked and numbers parsed once, in
+*   process(), and reported by errors().
+* - added value(option) and number(option, default) accessors
+* - options() now returns a read-only snapshot; use option(op, val)
+*   to set options
+* - fixed regex(const Regex&) which stored /r instead of /R
 * ver 1.7 : 04 Aug 2019
 * - replaced local option storage with pcl object
 * ver 1.6 : 01 Aug 2019
@@ -64,13 +108,67 @@
 #include <sstream>
 #include <iostream>
 #include <memory>
+#include <cstdlib>
+#include <cctype>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <limits>
+#include <type_traits>
+#include <algorithm>
+#include <stdexcept>
 #include "..//StringUtilities/StringUtilities.h"
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#include <charconv>
+#define UTILITIES_HAS_CHARCONV
+#if defined(__cpp_lib_to_chars)
+#define UTILITIES_HAS_CHARCONV_FP  // floating point to_chars and from_chars
+#endif
+#endif
+#endif
+
 namespace Utilities
 {
+  /////////////////////////////////////////////////////////////////////
+  // OptionType and defaultOptionType
+  // - schema for command line options, indexed by option character
+  // - flag:   takes no argument, e.g., /s
+  // - text:   requires an argument, e.g., /P path, /R regex
+  // - number: requires an integer argument, parsed once by process()
+  // - any:    argument is optional, used for undeclared options
+
+  enum class OptionType : char { any, flag, text, number };
+
+  constexpr OptionType defaultOptionType(char option)
+  {
+    switch (option)
+    {
+    case 'P': case 'p': case 'R': case 'F':
+      return OptionType::text;
+    case 'n':
+      return OptionType::number;
+    case 's': case 'h': case 'a': case 'f': case 'd':
+      return OptionType::flag;
+    default:
+      return OptionType::any;
+    }
+  }
+
   /////////////////////////////////////////////////////////////////////
   // ProcessCmdLine class
   // - extracts path, patterns, options, number
+  // - options live in a flat table with one slot per 7-bit character,
+  //   so every accessor is an array index, and numbers are parsed
+  //   once, in process(), rather than on each call
 
   class ProcessCmdLine
   {
@@ -85,19 +183,25 @@ namespace Utilities
     using Regex = std::string;
     using LogFile = std::string;
     using Number = long int;
+    using Errors = std::vector<std::string>;
 
     ProcessCmdLine(int argc, char** argv, std::ostream& out = std::cout);
-    ProcessCmdLine() : pOut_(&std::cout) {};
+    ProcessCmdLine() : pOut_(&std::cout) { initTable(); };
     ProcessCmdLine(const ProcessCmdLine& pcl) = delete;
     ProcessCmdLine& operator=(const ProcessCmdLine& pcl) = delete;
+    void declareOption(Option op, OptionType type);
     void process();
     void process(int argc, char** argv);
     bool parseError();
+    const Errors& errors();
     Path path();
     void path(const Path& path);
-    Options& options();
+    const std::vector<const char*>& roots();
+    const Options& options();
     void option(Option op, OptionValue val = "");
     bool hasOption(Option op);
+    OptionValue value(Option op);
+    Number number(Option op, Number defaultValue = 0);
     Patterns patterns();
     void pattern(const Pattern& patt);
     Number maxItems();
@@ -115,13 +219,31 @@ namespace Utilities
     void showMaxItems();
     void showRegex();
     void showLogFile();
+    void showErrors();
     void setUsageMessage(const std::string& msg);
   private:
+    struct OptionSlot
+    {
+      bool present = false;
+      OptionType type = OptionType::any;
+      OptionValue value;
+      Number number = 0;
+    };
+    static size_t slot(Option op) { return (unsigned char)op & 0x7F; }
+    void initTable();
+    bool parseSlot(Option op);
+    void expandResponseFiles();
+    bool readResponseFile(const char* fileSpec, std::vector<char*>& args, size_t depth);
     void defaultUsageMessage();
     int argc_ = 0;
     std::vector<char*> argv_;
+    std::vector<std::vector<char>> responseBuffers_;  // argv_ may point into these
+    std::vector<const char*> roots_;
+    std::vector<std::string> ownedRoots_;
     Patterns patterns_ = Patterns();
-    Options options_ = Options();
+    OptionSlot table_[128];
+    Options optionsView_ = Options();
+    Errors errors_ = Errors();
     bool parseError_ = false;
     std::ostream* pOut_;
     std::ostringstream msg_ = std::ostringstream();
@@ -136,19 +258,72 @@ namespace Utilities
     if (doReturn) out << "\n" << prefix << msg;
   }
 
+  /*----< option table operations >----------------------------------*/
+
+  inline void ProcessCmdLine::initTable()
+  {
+    for (size_t i = 0; i < 128; ++i)
+      table_[i].type = defaultOptionType((char)i);
+  }
+  //----< set type of option, call before process() >------------------
+
+  inline void ProcessCmdLine::declareOption(Option op, OptionType type)
+  {
+    table_[slot(op)].type = type;
+  }
+  //----< check value against option's type, parsing numbers >-------
+
+  inline bool ProcessCmdLine::parseSlot(Option op)
+  {
+    OptionSlot& entry = table_[slot(op)];
+    std::string name = std::string("/") + op;
+    switch (entry.type)
+    {
+    case OptionType::flag:
+      if (entry.value != "")
+        errors_.push_back(name + " takes no argument, found \"" + entry.value + "\"");
+      return entry.value == "";
+    case OptionType::text:
+      if (entry.value == "")
+        errors_.push_back(name + " requires an argument");
+      return entry.value != "";
+    case OptionType::number:
+    {
+      const char* pBeg = entry.value.c_str();
+      char* pEnd = nullptr;
+      entry.number = std::strtol(pBeg, &pEnd, 10);
+      if (entry.value == "" || *pEnd != '\0')
+      {
+        errors_.push_back(name + " requires a number, found \"" + entry.value + "\"");
+        entry.number = 0;
+        return false;
+      }
+      return true;
+    }
+    default:
+      return true;
+    }
+  }
+
   /*----< path operations >------------------------------------------*/
 
   inline void ProcessCmdLine::path(const Path& path) 
   { 
-    options_['P'] = path;
+    option('P', path);
+    ownedRoots_.assign(1, path);
+    roots_.assign(1, ownedRoots_[0].c_str());
   }
+  //----< first root, or "." if none >-------------------------------
 
   inline ProcessCmdLine::Path ProcessCmdLine::path()
   {
-    iterator iter = options_.find('P');
-    if (iter == options_.end())
-      return ".";
-    return iter->second;
+    return roots_.empty() ? "." : roots_[0];
+  }
+  //----< every path given with /P, in command line order >----------
+
+  inline const std::vector<const char*>& ProcessCmdLine::roots()
+  {
+    return roots_;
   }
 
   inline void ProcessCmdLine::showPath()
@@ -160,24 +335,52 @@ namespace Utilities
 
   inline void ProcessCmdLine::option(Option option, OptionValue optionValue)
   {
-    options_[option] = optionValue;
+    OptionSlot& entry = table_[slot(option)];
+    entry.present = true;
+    entry.value = optionValue;
+    if (entry.type == OptionType::number)
+      parseSlot(option);
   }
+  //----< snapshot of options as a map, for iteration and display >----
 
-  inline ProcessCmdLine::Options& ProcessCmdLine::options()
+  inline const ProcessCmdLine::Options& ProcessCmdLine::options()
   { 
-    return options_; 
+    optionsView_.clear();
+    for (size_t i = 0; i < 128; ++i)
+    {
+      if (table_[i].present)
+        optionsView_[(Option)i] = table_[i].value;
+    }
+    return optionsView_;
   }
 
   inline bool ProcessCmdLine::hasOption(Option opt)
   {
-    return options_.count(opt) > 0;
+    return table_[slot(opt)].present;
+  }
+  //----< option's argument, empty if absent >-------------------------
+
+  inline ProcessCmdLine::OptionValue ProcessCmdLine::value(Option opt)
+  {
+    const OptionSlot& entry = table_[slot(opt)];
+    return entry.present ? entry.value : "";
+  }
+  //----< numeric option's value, parsed when option was set >---------
+
+  inline ProcessCmdLine::Number ProcessCmdLine::number(Option opt, Number defaultValue)
+  {
+    const OptionSlot& entry = table_[slot(opt)];
+    if (!entry.present || entry.type != OptionType::number || entry.value == "")
+      return defaultValue;
+    return entry.number;
   }
 
   inline void ProcessCmdLine::showOptions()
   {
-    for (auto opt : options_)
+    for (size_t i = 0; i < 128; ++i)
     {
-      *pOut_ << '/' << opt.first << " " << opt.second << " ";
+      if (table_[i].present)
+        *pOut_ << '/' << (Option)i << " " << table_[i].value << " ";
     }
   }
 
@@ -209,15 +412,12 @@ namespace Utilities
 
   inline void ProcessCmdLine::maxItems(Number maxItems)
   {
-    options_['n'] = std::to_string(maxItems);
+    option('n', std::to_string(maxItems));
   }
 
   inline ProcessCmdLine::Number ProcessCmdLine::maxItems()
   {
-    iterator iter = options_.find('n');
-    if (iter == options_.end())
-      return 0;
-    return std::stol(iter->second);
+    return table_[slot('n')].number;
   }
 
   inline void ProcessCmdLine::showMaxItems()
@@ -229,17 +429,13 @@ namespace Utilities
 
   inline void ProcessCmdLine::regex(const Regex& rx)
   {
-    options_['r'] = rx;
+    option('R', rx);
   }
 
   inline ProcessCmdLine::Regex ProcessCmdLine::regex()
   {
-    iterator iter = options_.find('R');
-    if (iter == options_.end())
-      return ".*";
-    if (iter->second == "")
-      parseError_ = true;
-    return iter->second;
+    const OptionSlot& entry = table_[slot('R')];
+    return entry.present ? entry.value : ".*";
   }
 
   inline void ProcessCmdLine::showRegex()
@@ -251,17 +447,13 @@ namespace Utilities
 
   inline void ProcessCmdLine::logFile(const LogFile& lf)
   {
-    options_['F'] = lf;
+    option('F', lf);
   }
 
   inline ProcessCmdLine::LogFile ProcessCmdLine::logFile()
   {
-    iterator iter = options_.find('F');
-    if (iter == options_.end())
-      return "";
-    if (iter->second == "")
-      parseError_ = true;
-    return iter->second;
+    const OptionSlot& entry = table_[slot('F')];
+    return entry.present ? entry.value : "";
   }
 
   inline void ProcessCmdLine::showLogFile()
@@ -276,6 +468,17 @@ namespace Utilities
     return parseError_;
   }
 
+  inline const ProcessCmdLine::Errors& ProcessCmdLine::errors()
+  {
+    return errors_;
+  }
+
+  inline void ProcessCmdLine::showErrors()
+  {
+    for (auto& error : errors_)
+      *pOut_ << "\n  " << error;
+  }
+
   inline void ProcessCmdLine::showParse()
   {
     *pOut_ << "\n  ";
@@ -316,78 +519,155 @@ namespace Utilities
   inline void ProcessCmdLine::process(int argc, char** argv)
   {
     argc_ = argc;
-    for (int i = 0; i < argc; ++i)
-    {
-      argv_.push_back(argv[i]);
-    }
-    for (int i = 0; i < argc; ++i)
-    {
-      char* ptr = argv[i];
-      argv_[i] = argv[i];
-    }
+    argv_.assign(argv, argv + argc);
     process();
   }
+  //----< fill option table, then check each option against its type >-
 
   inline void ProcessCmdLine::process()
   {
     if (msg_.str() == "")
       defaultUsageMessage();
 
-    size_t i = 1;
-    while (i < argc_)
+    expandResponseFiles();
+
+    Option current = '\0';  // option that following values belong to
+    for (int i = 1; i < argc_; ++i)
     {
-      if (argv_[i][0] == '/')
+      // after /P, an argument is a root unless it is exactly /c for a
+      // known or declared option c, so "/P /home/x /s" gives a root
+      // and a flag on POSIX, on the command line and in @files alike
+      bool isOption = argv_[i][0] == '/';
+      if (isOption && current == 'P')
+        isOption = argv_[i][1] != '\0' && argv_[i][2] == '\0' &&
+          table_[slot(argv_[i][1])].type != OptionType::any;
+      if (isOption)
       {
-        options_[argv_[i][1]] = "";
+        current = argv_[i][1];
+        OptionSlot& entry = table_[slot(current)];
+        entry.present = true;
+        entry.value = "";
       }
-      else
+      else if (current == 'P')
       {
-        options_[argv_[i - 1][1]] = argv_[i];
+        roots_.push_back(argv_[i]);
+        table_[slot('P')].value = argv_[i];
       }
-      ++i;
-    }
-    Patterns splits;
-    for (auto optItem : options_)
-    {
-      switch (optItem.first)
+      else if (current != '\0')
       {
-      case 'P':
-        if (options_['P'] == "")
-          parseError_ = true;
-        break;
-      case 'p':
-        splits = split(optItem.second, ',');
-        for (auto patt : splits)
-          patterns_.push_back(patt);
-        break;
-      case 'n':
-        if (options_['n'] == "")
-          parseError_ = true;
-        break;
-      case 'R':
-        if (options_['R'] == "")
-          parseError_ = true;
-        break;
-      case 'F':
-        if (options_['F'] == "")
-          parseError_ = true;
-        break;
-      case 'h':
-        usage();
-        break;
-      default:
-        break;
+        table_[slot(current)].value = argv_[i];
       }
     }
 
-    if (path() == "")
-      path(".");
+    for (size_t i = 0; i < 128; ++i)
+    {
+      if (table_[i].present && !parseSlot((Option)i))
+        parseError_ = true;
+    }
+
+    const OptionSlot& patts = table_[slot('p')];
+    if (patts.present)
+    {
+      for (auto patt : split(patts.value, ','))
+        patterns_.push_back(patt);
+    }
+    if (hasOption('h'))
+      usage();
+
     if (patterns_.size() == 0)
       patterns_.push_back("*.*");
   }
 
+  //----< replace each @file argument with the lines of file >-------
+
+  inline void ProcessCmdLine::expandResponseFiles()
+  {
+    bool hasResponseFile = false;
+    for (int i = 1; i < argc_; ++i)
+    {
+      if (argv_[i][0] == '@')
+        hasResponseFile = true;
+    }
+    if (!hasResponseFile)
+      return;
+
+    std::vector<char*> args;
+    if (argc_ > 0)
+      args.push_back(argv_[0]);
+    for (int i = 1; i < argc_; ++i)
+    {
+      if (argv_[i][0] != '@')
+        args.push_back(argv_[i]);
+      else if (!readResponseFile(argv_[i] + 1, args, 0))
+        parseError_ = true;
+    }
+    argv_.swap(args);
+    argc_ = (int)argv_.size();
+  }
+  //----< read file in one block, splitting it in place into lines >-
+  /*
+  *  Lines are trimmed, and blank lines and lines starting with # are
+  *  skipped.  Each line is terminated in the buffer, and args points
+  *  to it, so no per argument allocation is made.  A line starting
+  *  with @ names a nested response file.
+  */
+  inline bool ProcessCmdLine::readResponseFile(const char* fileSpec, std::vector<char*>& args, size_t depth)
+  {
+    std::ifstream in(fileSpec, std::ios::binary | std::ios::ate);
+    std::streamoff size = in.good() && depth <= 8 ? (std::streamoff)in.tellg() : -1;
+    std::vector<char> buffer;
+    try
+    {
+      // a directory may give -1, a huge size, or a read that fails
+      if (size >= 0)
+      {
+        buffer.resize((size_t)size + 1);
+        in.seekg(0);
+        if (!in.read(buffer.data(), size))
+          size = -1;
+      }
+    }
+    catch (std::exception&)  // length_error or bad_alloc
+    {
+      size = -1;
+    }
+    if (size < 0)
+    {
+      errors_.push_back(std::string("can't read response file \"") + fileSpec + "\"");
+      return false;
+    }
+    buffer[(size_t)size] = '\0';
+    responseBuffers_.push_back(std::move(buffer));
+    char* pChar = responseBuffers_.back().data();
+    char* pEnd = pChar + size;
+
+    bool result = true;
+    while (pChar < pEnd)
+    {
+      char* pLine = pChar;
+      while (pChar < pEnd && *pChar != '\n')
+        ++pChar;
+      char* pLineEnd = pChar;
+      *pChar++ = '\0';
+      while (pLine < pLineEnd && std::isspace((unsigned char)*pLine))
+        ++pLine;
+      while (pLineEnd > pLine && std::isspace((unsigned char)pLineEnd[-1]))
+        *--pLineEnd = '\0';
+      if (pLine == pLineEnd || *pLine == '#')
+        continue;
+      if (*pLine == '@')
+        result = readResponseFile(pLine + 1, args, depth + 1) && result;
+      else
+        args.push_back(pLine);
+    }
+    return result;
+  }
+
   inline ProcessCmdLine::ProcessCmdLine(int argc, char** argv, std::ostream& out)
-    : argc_(argc), argv_(std::vector<char*>(argv, argv+argc)), pOut_(&out) {}
+    : argc_(argc), argv_(std::vector<char*>(argv, argv+argc)), pOut_(&out)
+  {
+    initTable();
+  }
 
   inline void ProcessCmdLine::showCmdLine(int argc, char** argv, bool showFirst)
   {
@@ -414,6 +694,10 @@ namespace Utilities
     msg_ << "\n      /R \"threads|sockets\"   // regular expression";
     msg_ << "\n      /F \"logFile.txt\"       // log file";
     msg_ << "\n      /n \"42\"                // max items";
+    msg_ << "\n      @args.txt              // read arguments, one per line, from file";
+    msg_ << "\n    /P may be followed by several paths, or repeated, to give many roots.";
+    msg_ << "\n    The list ends at an argument that is exactly /c for a known or";
+    msg_ << "\n    declared option c, e.g., /s, so /home/x is a path, in @files too";
     msg_ << "\n    /option has option type with no argument";
     msg_ << "\n    Examples:";
     msg_ << "\n      /s                       // recurse";
@@ -471,6 +755,262 @@ namespace Utilities
     return t;
   }
 
+  /////////////////////////////////////////////////////////////////////
+  // NumericConverter class
+  // - converts arithmetic types without building a stream, using
+  //   std::to_chars and std::from_chars where the library has them,
+  //   and snprintf and strtod otherwise
+  // - floating point values are written in the shortest form that
+  //   reads back to the same value
+  // - Converter<T> for the arithmetic types below derives from it
+  // - the caller-buffer overloads allocate nothing
+
+  template <typename T>
+  class NumericConverter
+  {
+  public:
+    static std::string toString(const T& t);
+    static size_t toString(const T& t, char* buffer, size_t bufSize);
+    static T toValue(const std::string& src);
+    static T toValue(const char* first, const char* last);
+    static bool toValue(const char* first, const char* last, T& value);
+  private:
+    static const size_t maxChars = 64;
+    static char* write(const T& t, char* first, char* last, std::false_type);
+    static char* write(const T& t, char* first, char* last, std::true_type);
+    static bool read(const char* first, const char* last, T& value, std::false_type);
+    static bool read(const char* first, const char* last, T& value, std::true_type);
+  };
+  //----< convert t to a string >--------------------------------------
+
+  template <typename T>
+  std::string NumericConverter<T>::toString(const T& t)
+  {
+    char buffer[maxChars];
+    size_t len = toString(t, buffer, maxChars);
+    return std::string(buffer, len);
+  }
+  //----< write t into caller's buffer >-------------------------------
+  /*
+  *  Returns the number of chars written, not counting the terminating
+  *  '\0' which is added when there is room, or 0 if t doesn't fit.
+  */
+  template <typename T>
+  size_t NumericConverter<T>::toString(const T& t, char* buffer, size_t bufSize)
+  {
+    char* end = write(t, buffer, buffer + bufSize, std::is_floating_point<T>());
+    if (end == nullptr)
+      return 0;
+    if (end < buffer + bufSize)
+      *end = '\0';
+    return end - buffer;
+  }
+  //----< convert a string to an instance of T >-----------------------
+  /*
+  *  - leading whitespace and a leading '+' are skipped, as istream does
+  *  - returns T() if src does not start with a T
+  */
+  template <typename T>
+  T NumericConverter<T>::toValue(const std::string& src)
+  {
+    return toValue(src.data(), src.data() + src.size());
+  }
+
+  template <typename T>
+  T NumericConverter<T>::toValue(const char* first, const char* last)
+  {
+    T value = T();
+    toValue(first, last, value);
+    return value;
+  }
+  //----< parse [first, last) into value, reporting success >----------
+
+  template <typename T>
+  bool NumericConverter<T>::toValue(const char* first, const char* last, T& value)
+  {
+    while (first < last && std::isspace((unsigned char)*first))
+      ++first;
+    if (first < last && *first == '+')
+      ++first;
+    return read(first, last, value, std::is_floating_point<T>());
+  }
+
+#if defined(UTILITIES_HAS_CHARCONV)
+
+  template <typename T>
+  char* NumericConverter<T>::write(const T& t, char* first, char* last, std::false_type)
+  {
+    std::to_chars_result result = std::to_chars(first, last, t);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+  }
+
+  template <typename T>
+  bool NumericConverter<T>::read(const char* first, const char* last, T& value, std::false_type)
+  {
+    std::from_chars_result result = std::from_chars(first, last, value);
+    return result.ec == std::errc();
+  }
+
+#else
+
+  template <typename T>
+  char* NumericConverter<T>::write(const T& t, char* first, char* last, std::false_type)
+  {
+    char digits[maxChars];
+    char* pDigit = digits + maxChars;
+    using Mag = typename std::make_unsigned<T>::type;
+    Mag mag = Mag(t);
+    if (t < 0)
+      mag = Mag(0 - mag);
+    do
+    {
+      *--pDigit = char('0' + mag % 10);
+      mag /= 10;
+    } while (mag != 0);
+    if (t < 0)
+      *--pDigit = '-';
+    size_t len = digits + maxChars - pDigit;
+    if (len > size_t(last - first))
+      return nullptr;
+    std::memcpy(first, pDigit, len);
+    return first + len;
+  }
+
+  template <typename T>
+  bool NumericConverter<T>::read(const char* first, const char* last, T& value, std::false_type)
+  {
+    bool negative = first < last && *first == '-';
+    if (negative)
+    {
+      if (!std::is_signed<T>::value)
+        return false;
+      ++first;
+    }
+    using Mag = typename std::make_unsigned<T>::type;
+    Mag limit = negative ? Mag(0) - Mag(std::numeric_limits<T>::min()) : Mag(std::numeric_limits<T>::max());
+    Mag mag = 0;
+    const char* start = first;
+    for (; first < last && '0' <= *first && *first <= '9'; ++first)
+    {
+      Mag digit = Mag(*first - '0');
+      if (mag > (limit - digit) / 10)
+        return false;
+      mag = Mag(mag * 10 + digit);
+    }
+    if (first == start)
+      return false;
+    value = negative ? T(Mag(0) - mag) : T(mag);
+    return true;
+  }
+
+#endif
+
+#if defined(UTILITIES_HAS_CHARCONV_FP)
+
+  template <typename T>
+  char* NumericConverter<T>::write(const T& t, char* first, char* last, std::true_type)
+  {
+    std::to_chars_result result = std::to_chars(first, last, t);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+  }
+
+  template <typename T>
+  bool NumericConverter<T>::read(const char* first, const char* last, T& value, std::true_type)
+  {
+    std::from_chars_result result = std::from_chars(first, last, value);
+    return result.ec == std::errc();
+  }
+
+#else
+
+  //----< try increasing precision until the text reads back as t >---
+
+  template <typename T>
+  char* NumericConverter<T>::write(const T& t, char* first, char* last, std::true_type)
+  {
+    char digits[maxChars];
+    int len = 0;
+    for (int precision = std::numeric_limits<T>::digits10; precision <= std::numeric_limits<T>::max_digits10; ++precision)
+    {
+      len = std::snprintf(digits, maxChars, "%.*Lg", precision, (long double)t);
+      if (len < 0 || len >= (int)maxChars)
+        return nullptr;
+      T readBack;
+      if (!read(digits, digits + len, readBack, std::true_type()) || readBack == t || t != t)
+        break;
+    }
+    if (size_t(len) > size_t(last - first))
+      return nullptr;
+    std::memcpy(first, digits, len);
+    return first + len;
+  }
+  //----< strtod needs a terminated string, so copy into one >---------
+
+  template <typename T>
+  bool NumericConverter<T>::read(const char* first, const char* last, T& value, std::true_type)
+  {
+    char text[maxChars];
+    size_t len = size_t(last - first) < maxChars - 1 ? size_t(last - first) : maxChars - 1;
+    std::memcpy(text, first, len);
+    text[len] = '\0';
+    char* end = nullptr;
+    errno = 0;
+    long double result = std::strtold(text, &end);
+    if (end == text || errno == ERANGE)
+      return false;
+    value = T(result);
+    return true;
+  }
+
+#endif
+
+  template <> class Converter<short> : public NumericConverter<short> {};
+  template <> class Converter<unsigned short> : public NumericConverter<unsigned short> {};
+  template <> class Converter<int> : public NumericConverter<int> {};
+  template <> class Converter<unsigned int> : public NumericConverter<unsigned int> {};
+  template <> class Converter<long> : public NumericConverter<long> {};
+  template <> class Converter<unsigned long> : public NumericConverter<unsigned long> {};
+  template <> class Converter<long long> : public NumericConverter<long long> {};
+  template <> class Converter<unsigned long long> : public NumericConverter<unsigned long long> {};
+  template <> class Converter<float> : public NumericConverter<float> {};
+  template <> class Converter<double> : public NumericConverter<double> {};
+  template <> class Converter<long double> : public NumericConverter<long double> {};
+
+  /////////////////////////////////////////////////////////////////////
+  // Converter<bool>
+  // - writes "1" or "0", as an unmodified ostream does
+  // - reads "1", "0", "true", or "false"
+
+  template <>
+  class Converter<bool>
+  {
+  public:
+    static std::string toString(const bool& t)
+    {
+      return t ? "1" : "0";
+    }
+    static size_t toString(const bool& t, char* buffer, size_t bufSize)
+    {
+      if (bufSize == 0)
+        return 0;
+      buffer[0] = t ? '1' : '0';
+      if (bufSize > 1)
+        buffer[1] = '\0';
+      return 1;
+    }
+    static bool toValue(const std::string& src)
+    {
+      return toValue(src.data(), src.data() + src.size());
+    }
+    static bool toValue(const char* first, const char* last)
+    {
+      while (first < last && std::isspace((unsigned char)*first))
+        ++first;
+      size_t len = last - first;
+      return (len >= 1 && *first == '1') || (len >= 4 && std::strncmp(first, "true", 4) == 0);
+    }
+  };
+
   ///////////////////////////////////////////////////////////////////////
   // Box class
   // - wraps primitive type in class
@@ -483,18 +1023,749 @@ namespace Utilities
     Box() : primitive_(T()) {}
     Box(const T& t) : primitive_(t) {}
     operator T&() { return primitive_; }
+    operator const T&() const { return primitive_; }
     T& operator=(const T& t) { primitive_ = t; return primitive_; }
   private:
     T primitive_;
   };
 
+  ///////////////////////////////////////////////////////////////////////
+  // DocWriter class
+  // - base for XmlWriter and JsonWriter, which serialize a document
+  //   element by element into one growable buffer, reused for the
+  //   life of the writer
+  // - with a sink, an ostream or a file descriptor, the buffer is
+  //   written out whenever it grows past flushSize, so memory stays
+  //   bounded however large the document is
+  // - without a sink, str() holds the whole document
+  // - text is escaped a run at a time, appending the spans between
+  //   special characters with single appends
+
+  class DocWriter
+  {
+  public:
+    DocWriter(size_t flushSize = 64 * 1024);
+    DocWriter(const DocWriter&) = delete;
+    DocWriter& operator=(const DocWriter&) = delete;
+    virtual ~DocWriter();
+
+    void sink(std::ostream& out);
+    void sink(int fileDescriptor);
+    bool flush();
+    const std::string& str() const { return buffer_; }
+    size_t bytesWritten() const { return flushed_ + buffer_.size(); }
+
+    virtual void beginObject(const std::string& tag) = 0;
+    virtual void endObject(const std::string& tag) = 0;
+    virtual void beginArray(const std::string& tag) = 0;
+    virtual void endArray(const std::string& tag) = 0;
+    virtual void xmlFragment(const std::string& tag, const std::string& xml) = 0;
+    virtual void finish() {}
+
+    void field(const std::string& tag, const std::string& text);
+    void field(const std::string& tag, const char* text);
+    void field(const std::string& tag, bool value);
+    template<typename T>
+    void field(const std::string& tag, const Box<T>& value);
+    template<typename T>
+    void field(const std::string& tag, const T& value);
+  protected:
+    virtual void leaf(const std::string& tag, const char* text, size_t len, bool isText) = 0;
+    void append(const char* text, size_t len);
+    void append(const std::string& text) { append(text.data(), text.size()); }
+    void append(char ch) { buffer_ += ch; }
+    void appendXmlEscaped(const char* text, size_t len);
+    void appendJsonEscaped(const char* text, size_t len);
+    void checkFlush();
+  private:
+    template<typename T>
+    void field(const std::string& tag, const T& value, std::true_type);
+    template<typename T>
+    void field(const std::string& tag, const T& value, std::false_type);
+
+    std::string buffer_;
+    size_t flushSize_;
+    size_t flushed_ = 0;
+    std::ostream* pOut_ = nullptr;
+    int fd_ = -1;
+  };
+
+  inline DocWriter::DocWriter(size_t flushSize) : flushSize_(flushSize)
+  {
+    buffer_.reserve(flushSize + 1024);
+  }
+  //----< write out whatever a sink has not yet received >-------------
+
+  inline DocWriter::~DocWriter()
+  {
+    flush();
+  }
+  //----< send output to out, flushing each flushSize bytes >----------
+
+  inline void DocWriter::sink(std::ostream& out)
+  {
+    flush();
+    pOut_ = &out;
+    fd_ = -1;
+  }
+  //----< send output to an open file descriptor >---------------------
+
+  inline void DocWriter::sink(int fileDescriptor)
+  {
+    flush();
+    fd_ = fileDescriptor;
+    pOut_ = nullptr;
+  }
+  //----< write buffer to sink, keeping its capacity >-----------------
+  /*
+  *  Returns false if the sink failed.  Does nothing without a sink.
+  */
+  inline bool DocWriter::flush()
+  {
+    if (pOut_ == nullptr && fd_ < 0)
+      return true;
+    bool ok = true;
+    if (pOut_)
+    {
+      pOut_->write(buffer_.data(), buffer_.size());
+      ok = pOut_->good();
+    }
+    else
+    {
+      const char* pData = buffer_.data();
+      size_t remaining = buffer_.size();
+      while (remaining > 0)
+      {
+#ifdef _WIN32
+        int count = _write(fd_, pData, (unsigned)remaining);
+#else
+        ssize_t count = ::write(fd_, pData, remaining);
+        if (count < 0 && errno == EINTR)
+          continue;
+#endif
+        if (count <= 0)
+        {
+          ok = false;
+          break;
+        }
+        pData += count;
+        remaining -= count;
+      }
+    }
+    flushed_ += buffer_.size();
+    buffer_.clear();
+    return ok;
+  }
+
+  inline void DocWriter::checkFlush()
+  {
+    if (buffer_.size() >= flushSize_)
+      flush();
+  }
+
+  inline void DocWriter::append(const char* text, size_t len)
+  {
+    buffer_.append(text, len);
+  }
+  //----< append text with &, <, >, ", and ' replaced by entities >----
+
+  inline void DocWriter::appendXmlEscaped(const char* text, size_t len)
+  {
+    const char* runStart = text;
+    const char* end = text + len;
+    for (const char* pChar = text; pChar < end; ++pChar)
+    {
+      const char* entity;
+      switch (*pChar)
+      {
+      case '&': entity = "&amp;"; break;
+      case '<': entity = "&lt;"; break;
+      case '>': entity = "&gt;"; break;
+      case '"': entity = "&quot;"; break;
+      case '\'': entity = "&apos;"; break;
+      default: continue;
+      }
+      buffer_.append(runStart, pChar - runStart);
+      buffer_.append(entity);
+      runStart = pChar + 1;
+    }
+    buffer_.append(runStart, end - runStart);
+  }
+  //----< append text with quotes, backslashes, and controls escaped >-
+
+  inline void DocWriter::appendJsonEscaped(const char* text, size_t len)
+  {
+    static const char hexDigits[] = "0123456789abcdef";
+    const char* runStart = text;
+    const char* end = text + len;
+    for (const char* pChar = text; pChar < end; ++pChar)
+    {
+      unsigned char ch = (unsigned char)*pChar;
+      if (ch >= 0x20 && ch != '"' && ch != '\\')
+        continue;
+      buffer_.append(runStart, pChar - runStart);
+      runStart = pChar + 1;
+      switch (ch)
+      {
+      case '"': buffer_.append("\\\""); break;
+      case '\\': buffer_.append("\\\\"); break;
+      case '\n': buffer_.append("\\n"); break;
+      case '\r': buffer_.append("\\r"); break;
+      case '\t': buffer_.append("\\t"); break;
+      default:
+        char escape[] = { '\\', 'u', '0', '0', hexDigits[ch >> 4], hexDigits[ch & 0xf] };
+        buffer_.append(escape, sizeof(escape));
+      }
+    }
+    buffer_.append(runStart, end - runStart);
+  }
+  //----< write leaf elements >----------------------------------------
+
+  inline void DocWriter::field(const std::string& tag, const std::string& text)
+  {
+    leaf(tag, text.data(), text.size(), true);
+  }
+
+  inline void DocWriter::field(const std::string& tag, const char* text)
+  {
+    leaf(tag, text, std::strlen(text), true);
+  }
+
+  inline void DocWriter::field(const std::string& tag, bool value)
+  {
+    leaf(tag, value ? "true" : "false", value ? 4 : 5, false);
+  }
+
+  template<typename T>
+  void DocWriter::field(const std::string& tag, const Box<T>& value)
+  {
+    field(tag, static_cast<const T&>(value));
+  }
+  //----< numbers are formatted in place, other types with Converter >-
+
+  template<typename T>
+  void DocWriter::field(const std::string& tag, const T& value)
+  {
+    field(tag, value, std::is_arithmetic<T>());
+  }
+
+  template<typename T>
+  void DocWriter::field(const std::string& tag, const T& value, std::true_type)
+  {
+    char number[64];
+    size_t len = Converter<T>::toString(value, number, sizeof(number));
+    leaf(tag, number, len, false);
+  }
+
+  template<typename T>
+  void DocWriter::field(const std::string& tag, const T& value, std::false_type)
+  {
+    field(tag, Converter<T>::toString(value));
+  }
+
+  ///////////////////////////////////////////////////////////////////////
+  // XmlWriter class
+  // - writes <tag>text</tag> elements, with no indentation and a
+  //   newline after each top level element
+  // - arrays are wrapper elements holding one element per item
+
+  class XmlWriter : public DocWriter
+  {
+  public:
+    XmlWriter(size_t flushSize = 64 * 1024) : DocWriter(flushSize) {}
+    void beginObject(const std::string& tag) override { open(tag); }
+    void endObject(const std::string& tag) override { close(tag); }
+    void beginArray(const std::string& tag) override { open(tag); }
+    void endArray(const std::string& tag) override { close(tag); }
+    void xmlFragment(const std::string& tag, const std::string& xml) override;
+  protected:
+    void leaf(const std::string& tag, const char* text, size_t len, bool isText) override;
+  private:
+    void open(const std::string& tag);
+    void close(const std::string& tag);
+    size_t depth_ = 0;
+  };
+
+  inline void XmlWriter::open(const std::string& tag)
+  {
+    append('<');
+    append(tag);
+    append('>');
+    ++depth_;
+  }
+
+  inline void XmlWriter::close(const std::string& tag)
+  {
+    append("</", 2);
+    append(tag);
+    append('>');
+    if (depth_ > 0 && --depth_ == 0)
+      append('\n');
+    checkFlush();
+  }
+
+  inline void XmlWriter::leaf(const std::string& tag, const char* text, size_t len, bool isText)
+  {
+    open(tag);
+    if (isText)
+      appendXmlEscaped(text, len);
+    else
+      append(text, len);
+    close(tag);
+  }
+  //----< xml from ToXml::toXml(tag) is already an element >-----------
+
+  inline void XmlWriter::xmlFragment(const std::string&, const std::string& xml)
+  {
+    append(xml);
+    if (depth_ == 0)
+      append('\n');
+    checkFlush();
+  }
+
+  ///////////////////////////////////////////////////////////////////////
+  // JsonWriter class
+  // - writes newline delimited JSON: each top level element is one
+  //   line holding a one member object, {"tag":...}, so repeated
+  //   tags, e.g., a stream of records, never give duplicate keys.
+  //   Like XmlWriter's output, the lines are separate documents.
+  // - tags name object members and are ignored for array items
+  // - finish() or the destructor closes anything left open
+  // - numbers and bools are written bare, everything else as strings
+
+  class JsonWriter : public DocWriter
+  {
+  public:
+    JsonWriter(size_t flushSize = 64 * 1024) : DocWriter(flushSize) {}
+    ~JsonWriter() { finish(); }
+    void beginObject(const std::string& tag) override { open(tag, '{'); }
+    void endObject(const std::string&) override { close('}'); }
+    void beginArray(const std::string& tag) override { open(tag, '['); }
+    void endArray(const std::string&) override { close(']'); }
+    void xmlFragment(const std::string& tag, const std::string& xml) override;
+    void finish() override;
+  protected:
+    void leaf(const std::string& tag, const char* text, size_t len, bool isText) override;
+  private:
+    void key(const std::string& tag);
+    void open(const std::string& tag, char bracket);
+    void close(char bracket);
+    void endLine();
+
+    enum Scope : char { object, objectWithItems, array, arrayWithItems };
+    std::vector<Scope> scopes_;  // grows to the element's depth, then is reused
+  };
+  //----< write separator and, inside an object, "tag": >---------------
+  // - a top level element starts a new line's object
+
+  inline void JsonWriter::key(const std::string& tag)
+  {
+    if (scopes_.empty())
+    {
+      append('{');
+      scopes_.push_back(object);
+    }
+    Scope& scope = scopes_.back();
+    if (scope == objectWithItems || scope == arrayWithItems)
+      append(',');
+    if (scope == object || scope == objectWithItems)
+    {
+      scope = objectWithItems;
+      append('"');
+      appendJsonEscaped(tag.data(), tag.size());
+      append("\":", 2);
+    }
+    else
+      scope = arrayWithItems;
+  }
+
+  inline void JsonWriter::open(const std::string& tag, char bracket)
+  {
+    key(tag);
+    append(bracket);
+    scopes_.push_back(bracket == '{' ? object : array);
+  }
+
+  inline void JsonWriter::close(char bracket)
+  {
+    if (scopes_.size() < 2)  // nothing open below the line's object
+      return;
+    append(bracket);
+    scopes_.pop_back();
+    endLine();
+  }
+  //----< a completed top level element closes its line >--------------
+
+  inline void JsonWriter::endLine()
+  {
+    if (scopes_.size() == 1)
+    {
+      append("}\n", 2);
+      scopes_.pop_back();
+    }
+    checkFlush();
+  }
+
+  inline void JsonWriter::leaf(const std::string& tag, const char* text, size_t len, bool isText)
+  {
+    key(tag);
+    if (isText)
+    {
+      append('"');
+      appendJsonEscaped(text, len);
+      append('"');
+    }
+    else
+      append(text, len);
+    endLine();
+  }
+  //----< xml has no JSON form, so it is kept as a string >------------
+
+  inline void JsonWriter::xmlFragment(const std::string& tag, const std::string& xml)
+  {
+    leaf(tag, xml.data(), xml.size(), true);
+  }
+  //----< close everything still open, ending the last line >---------
+
+  inline void JsonWriter::finish()
+  {
+    if (scopes_.empty())
+      return;
+    while (!scopes_.empty())
+    {
+      Scope scope = scopes_.back();
+      append(scope == array || scope == arrayWithItems ? ']' : '}');
+      scopes_.pop_back();
+    }
+    append('\n');
+    checkFlush();
+  }
+
+  ///////////////////////////////////////////////////////////////////////
+  // XmlReader class
+  // - pull parser over a buffer the caller owns, e.g., the data() and
+  //   size() of a FileSystem::MappedFile.  next() returns one token at
+  //   a time, and name() and rawText() are spans into the buffer, so
+  //   nothing is copied until a value is asked for.
+  // - memory use depends only on element depth, not document size
+  // - <tag/> yields startElement then endElement
+  // - comments, processing instructions, <!DOCTYPE>, and whitespace
+  //   between elements are skipped; CDATA is returned as text.
+  //   Whitespace that is all of an element's text, <name>   </name>,
+  //   is returned, so blank values read back as written.
+  // - attributes are not parsed, but are available as a raw span
+  // - on malformed input next() returns error and errorMsg() says why
+
+  struct TextSpan
+  {
+    const char* first = nullptr;
+    const char* last = nullptr;
+
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    std::string str() const { return std::string(first, last); }
+    bool operator==(const std::string& s) const
+    {
+      return size() == s.size() && std::memcmp(first, s.data(), s.size()) == 0;
+    }
+    bool operator!=(const std::string& s) const { return !(*this == s); }
+    bool operator==(const TextSpan& s) const
+    {
+      return size() == s.size() && std::memcmp(first, s.first, size()) == 0;
+    }
+  };
+
+  class XmlReader
+  {
+  public:
+    enum Token { startElement, endElement, characters, endOfDocument, error };
+
+    XmlReader(const char* first, const char* last);
+    XmlReader(const std::string& doc);  // doc must outlive the reader
+    XmlReader(std::string&& doc) = delete;
+
+    Token next();
+    Token token() const { return token_; }
+    TextSpan name() const { return name_; }
+    TextSpan attributes() const { return attributes_; }
+    TextSpan rawText() const { return text_; }
+    std::string text() const;
+    void text(std::string& out) const;
+    size_t depth() const { return open_.size(); }
+    size_t offset() const { return pos_ - first_; }
+    const std::string& errorMsg() const { return errorMsg_; }
+
+    template<typename T>
+    void value(T& t) const;
+    void value(std::string& t) const { text(t); }
+    template<typename T>
+    void value(Box<T>& t) const { value(static_cast<T&>(t)); }
+
+    template<typename T>
+    bool read(const std::string& tag, T& t);
+    bool skip();
+  private:
+    template<typename T>
+    void value(T& t, std::true_type) const;
+    template<typename T>
+    void value(T& t, std::false_type) const;
+    const char* find(const char* pattern) const;
+    Token fail(const std::string& msg);
+    static void appendUtf8(std::string& out, unsigned long codePoint);
+
+    const char* first_;
+    const char* last_;
+    const char* pos_;
+    Token token_ = endOfDocument;
+    TextSpan name_;
+    TextSpan attributes_;
+    TextSpan text_;
+    bool cdata_ = false;
+    bool closePending_ = false;
+    std::vector<TextSpan> open_;  // names of open elements
+    std::string errorMsg_;
+  };
+
+  inline XmlReader::XmlReader(const char* first, const char* last)
+    : first_(first), last_(last), pos_(first) {}
+
+  inline XmlReader::XmlReader(const std::string& doc)
+    : XmlReader(doc.data(), doc.data() + doc.size()) {}
+
+  //----< find pattern at or after current position, or last_ >-------
+
+  inline const char* XmlReader::find(const char* pattern) const
+  {
+    const char* pEnd = pattern + std::strlen(pattern);
+    const char* found = std::search(pos_, last_, pattern, pEnd);
+    return found == last_ ? last_ : found + (pEnd - pattern);
+  }
+
+  inline XmlReader::Token XmlReader::fail(const std::string& msg)
+  {
+    errorMsg_ = msg + " at offset " + std::to_string(offset());
+    return token_ = error;
+  }
+  //----< advance to the next element boundary or text >--------------
+
+  inline XmlReader::Token XmlReader::next()
+  {
+    if (token_ == error)
+      return token_;
+    if (closePending_)
+    {
+      closePending_ = false;
+      open_.pop_back();
+      return token_ = endElement;
+    }
+    while (pos_ < last_)
+    {
+      if (*pos_ != '<')
+      {
+        const char* start = pos_;
+        const char* pLt = (const char*)std::memchr(pos_, '<', last_ - pos_);
+        pos_ = pLt ? pLt : last_;
+        bool blank = true;
+        for (const char* pChar = start; blank && pChar < pos_; ++pChar)
+          blank = std::isspace((unsigned char)*pChar) != 0;
+        bool leafText = token_ == startElement && last_ - pos_ >= 2 && pos_[1] == '/';
+        if (blank && !leafText)
+          continue;
+        text_ = TextSpan{ start, pos_ };
+        cdata_ = false;
+        return token_ = characters;
+      }
+      if (last_ - pos_ >= 4 && std::memcmp(pos_, "<!--", 4) == 0)
+      {
+        pos_ = find("-->");
+        continue;
+      }
+      if (last_ - pos_ >= 9 && std::memcmp(pos_, "<![CDATA[", 9) == 0)
+      {
+        const char* start = pos_ + 9;
+        pos_ = find("]]>");
+        if (pos_ == last_)
+          return fail("unterminated CDATA");
+        text_ = TextSpan{ start, pos_ - 3 };
+        cdata_ = true;
+        return token_ = characters;
+      }
+      if (last_ - pos_ >= 2 && (pos_[1] == '?' || pos_[1] == '!'))
+      {
+        pos_ = find(">");
+        continue;
+      }
+      const char* pGt = (const char*)std::memchr(pos_, '>', last_ - pos_);
+      if (pGt == nullptr)
+        return fail("unterminated tag");
+      bool isEnd = pos_[1] == '/';
+      const char* nameStart = pos_ + (isEnd ? 2 : 1);
+      const char* nameEnd = nameStart;
+      while (nameEnd < pGt && !std::isspace((unsigned char)*nameEnd) && *nameEnd != '/')
+        ++nameEnd;
+      if (nameEnd == nameStart)
+        return fail("missing element name");
+      name_ = TextSpan{ nameStart, nameEnd };
+      pos_ = pGt + 1;
+      if (isEnd)
+      {
+        if (open_.empty() || !(open_.back() == name_))
+          return fail("unmatched </" + name_.str() + ">");
+        open_.pop_back();
+        return token_ = endElement;
+      }
+      bool selfClosing = pGt[-1] == '/';
+      attributes_ = TextSpan{ nameEnd, selfClosing ? pGt - 1 : pGt };
+      open_.push_back(name_);
+      closePending_ = selfClosing;
+      return token_ = startElement;
+    }
+    if (!open_.empty())
+      return fail("unclosed <" + open_.back().str() + ">");
+    return token_ = endOfDocument;
+  }
+  //----< text with entities replaced, reusing out's capacity >--------
+
+  inline void XmlReader::text(std::string& out) const
+  {
+    out.clear();
+    if (cdata_)
+    {
+      out.assign(text_.first, text_.last);
+      return;
+    }
+    const char* runStart = text_.first;
+    const char* pChar = text_.first;
+    while (pChar < text_.last)
+    {
+      if (*pChar != '&')
+      {
+        ++pChar;
+        continue;
+      }
+      const char* pSemi = (const char*)std::memchr(pChar, ';', text_.last - pChar);
+      if (pSemi == nullptr)
+        break;
+      out.append(runStart, pChar);
+      TextSpan entity{ pChar + 1, pSemi };
+      if (entity == "amp") out += '&';
+      else if (entity == "lt") out += '<';
+      else if (entity == "gt") out += '>';
+      else if (entity == "quot") out += '"';
+      else if (entity == "apos") out += '\'';
+      else if (entity.size() > 1 && entity.first[0] == '#')
+      {
+        bool hex = entity.first[1] == 'x' || entity.first[1] == 'X';
+        std::string digits(entity.first + (hex ? 2 : 1), entity.last);
+        appendUtf8(out, std::strtoul(digits.c_str(), nullptr, hex ? 16 : 10));
+      }
+      else
+        out.append(pChar, pSemi + 1);  // unknown entity kept as is
+      pChar = runStart = pSemi + 1;
+    }
+    out.append(runStart, text_.last);
+  }
+
+  inline std::string XmlReader::text() const
+  {
+    std::string out;
+    text(out);
+    return out;
+  }
+
+  inline void XmlReader::appendUtf8(std::string& out, unsigned long codePoint)
+  {
+    if (codePoint < 0x80)
+      out += char(codePoint);
+    else if (codePoint < 0x800)
+    {
+      out += char(0xC0 | (codePoint >> 6));
+      out += char(0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint < 0x10000)
+    {
+      out += char(0xE0 | (codePoint >> 12));
+      out += char(0x80 | ((codePoint >> 6) & 0x3F));
+      out += char(0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+      out += char(0xF0 | (codePoint >> 18));
+      out += char(0x80 | ((codePoint >> 12) & 0x3F));
+      out += char(0x80 | ((codePoint >> 6) & 0x3F));
+      out += char(0x80 | (codePoint & 0x3F));
+    }
+  }
+  //----< convert current text to t, numbers straight from the span >-
+
+  template<typename T>
+  void XmlReader::value(T& t) const
+  {
+    value(t, std::is_arithmetic<T>());
+  }
+
+  template<typename T>
+  void XmlReader::value(T& t, std::true_type) const
+  {
+    t = Converter<T>::toValue(text_.first, text_.last);
+  }
+
+  template<typename T>
+  void XmlReader::value(T& t, std::false_type) const
+  {
+    t = Converter<T>::toValue(text());
+  }
+  //----< read the next element, <tag>value</tag>, into t >------------
+  /*
+  *  An empty element leaves t default constructed.  Returns false,
+  *  leaving the reader where the mismatch was found, if the next
+  *  element isn't tag.
+  */
+  template<typename T>
+  bool XmlReader::read(const std::string& tag, T& t)
+  {
+    if (next() != startElement || name_ != tag)
+      return false;
+    t = T();
+    if (next() == characters)
+    {
+      value(t);
+      next();
+    }
+    return token_ == endElement;
+  }
+  //----< after startElement, move past its matching endElement >-----
+
+  inline bool XmlReader::skip()
+  {
+    if (token_ != startElement)
+      return false;
+    size_t target = depth() - 1;
+    while (depth() > target)
+    {
+      Token tok = next();
+      if (tok == error || tok == endOfDocument)
+        return false;
+    }
+    return true;
+  }
+
   ///////////////////////////////////////////////////////////////////////
   // ToXml interface
   // - defines language for creating XML elements
+  // - toXml(writer, tag) serializes into an XmlWriter or JsonWriter.
+  //   The default wraps toXml(tag), so existing implementations keep
+  //   working; override it to write fields without building strings.
+  //   Classes that override only toXml(tag) need "using ToXml::toXml;"
+  //   to call the writer form.
 
   struct ToXml
   {
     virtual std::string toXml(const std::string& tag) = 0;
+    virtual void toXml(DocWriter& writer, const std::string& tag)
+    {
+      writer.xmlFragment(tag, toXml(tag));
+    }
     virtual ~ToXml() {};
   };
 
@@ -502,7 +1773,10 @@ namespace Utilities
   // PersistFactory<T> class
   // - wraps an instance of user-defined type
   // - preserves semantics of user-defined type
-  // - adds toXml("tag") method
+  // - adds toXml("tag") method, and toXml(writer, "tag") which writes
+  //   the value as a field, with no temporary string for strings and
+  //   numbers
+  // - fromXml(reader, "tag") reads the value back from the next element
 
   template<typename T>
   class PersistFactory : public T, ToXml
@@ -519,5 +1793,13 @@ namespace Utilities
       out << "<" << tag << ">" << *this << "</" << tag << ">";
       return out.str();
     }
+    void toXml(DocWriter& writer, const std::string& tag)
+    {
+      writer.field(tag, static_cast<const T&>(*this));
+    }
+    bool fromXml(XmlReader& reader, const std::string& tag)
+    {
+      return reader.read(tag, static_cast<T&>(*this));
+    }
   };
 }
\ No newline at end of file
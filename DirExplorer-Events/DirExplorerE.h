@@ -1,7 +1,7 @@
 #pragma once
 /////////////////////////////////////////////////////////////////////
 // DirExplorerE.h - directory explorer uses events                 //
-// ver 1.3                                                         //
+// ver 1.4                                                         //
 // Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018         //
 /////////////////////////////////////////////////////////////////////
 /*
@@ -33,11 +33,15 @@
 * ---------------
 * DirExplorerE.h, DirExplorerE.cpp
 * FileSystem.h, FileSystem.cpp      // Directory and Path classes
+* PathResolver.h                    // absolute paths without syscalls
 * StringUtilities.h                 // Title function
 * CodeUtilities.h                   // ProcessCmdLine class
 *
 * Maintenance History:
 * --------------------
+* ver 1.4 : 19 Oct 2026
+* - find resolves paths with a PathResolver, so directories below the
+*   root cost no Path::getFullFileSpec call
 * ver 1.3 : 24 Jun 2019
 * - minor fixes due to change in CodeUtilities::ProcessCmdLine
 * ver 1.2 : 19 Aug 2018
@@ -54,6 +58,7 @@
 #include <iostream>
 #include <memory>
 #include "../FileSystem/FileSystem.h"
+#include "../FileSystem/PathResolver.h"
 #include "../CodeUtilities/CodeUtilities.h"
 
 namespace FileSystem
@@ -84,7 +89,7 @@ namespace FileSystem
   public:
     using patterns = std::vector<std::string>;
 
-    static std::string version() { return "ver1.2"; }
+    static std::string version() { return "ver1.4"; }
 
     DirExplorerE(const std::string& path);
     virtual ~DirExplorerE() {}
@@ -125,6 +130,7 @@ namespace FileSystem
     size_t dirCount_ = 0;
     size_t fileCount_ = 0;
     bool recurse_ = false;
+    PathResolver resolver_;
   };
 
   //----< construct DirExplorerN instance with default pattern >-----
@@ -212,6 +218,7 @@ namespace FileSystem
 
   inline void DirExplorerE::search()
   {
+    resolver_.clear();
     find(path_);
   }
   //----< search for directories and their files >-------------------
@@ -226,7 +233,7 @@ namespace FileSystem
       return;
 
     bool hasFiles = false;
-    std::string fpath = FileSystem::Path::getFullFileSpec(path);
+    std::string fpath = resolver_.resolve(path);  // just a scan, once path is absolute
     if (!hideEmptyDir_)
     {
       notifyDir(fpath);
@@ -256,7 +263,7 @@ namespace FileSystem
     {
       if (d == "." || d == "..")
         continue;
-      std::string dpath = fpath + "\\" + d;
+      std::string dpath = resolver_.resolve(fpath, d);
       if (recurse_)
       {
         find(dpath);
@@ -1,6 +1,6 @@
 /////////////////////////////////////////////////////////////////////
 // DirExplorerT.cpp - Template directory explorer                  //
-// ver 1.2                                                         //
+// ver 1.3                                                         //
 // Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018         //
 /////////////////////////////////////////////////////////////////////
 
@@ -19,8 +19,9 @@ using namespace FileSystem;
 std::string customUsage()
 {
   std::string usage;
-  usage += "\n  Command Line: path [/option]* [/pattern]*";
-  usage += "\n    path is relative or absolute path where processing begins";
+  usage += "\n  Command Line: /P path [path]* [/option]* [/p pattern,...]";
+  usage += "\n    path is relative or absolute path where processing begins,";
+  usage += "\n    more paths are searched in turn, @file reads arguments from file";
   usage += "\n    [/option]* are one or more options of the form:";
   usage += "\n      /s - walk directory recursively";
   usage += "\n      /h - hide empty directories";
@@ -37,6 +38,7 @@ int main(int argc, char *argv[])
 
   ProcessCmdLine pcl(argc, argv);
   pcl.usage(customUsage());
+  pcl.process();
 
   preface("Command Line: ");
   pcl.showParse();
@@ -50,6 +52,10 @@ int main(int argc, char *argv[])
   }
 
   DirExplorerT<Application> de(pcl.path());
+  for (size_t i = 1; i < pcl.roots().size(); ++i)
+  {
+    de.addPath(pcl.roots()[i]);
+  }
 
   for (auto patt : pcl.patterns())
   {
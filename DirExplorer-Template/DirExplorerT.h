@@ -1,7 +1,7 @@
 #pragma once
 /////////////////////////////////////////////////////////////////////
 // DirExplorerT.h - Template directory explorer                    //
-// ver 1.2                                                         //
+// ver 1.6                                                         //
 // Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018         //
 /////////////////////////////////////////////////////////////////////
 /*
@@ -28,11 +28,25 @@
 * DirExplorerT.h, DirExplorerT.cpp
 * Application.h, Application.cpp    // provides defn's for doDir and doFile
 * FileSystem.h, FileSystem.cpp      // Directory and Path classes
+* PathResolver.h                    // absolute paths without syscalls
 * StringUtilities.h                 // Title function
 * CodeUtilities.h                   // ProcessCmdLine class
 *
 * Maintenance History:
 * --------------------
+* ver 1.6 : 19 Oct 2026
+* - search resolves each root once with a PathResolver, then builds
+*   child paths by appending names, rather than calling
+*   Path::getFullFileSpec in every directory
+* ver 1.5 : 19 Oct 2026
+* - added addPath, so one search can walk a list of roots
+* ver 1.4 : 19 Oct 2026
+* - find collects names in NameArenas rather than string vectors;
+*   the file arena and a name buffer are reused for every directory
+* ver 1.3 : 19 Oct 2026
+* - added app() so applications can be queried after search
+* - fixed fileCount() and dirCount() which named the type App
+*   instead of the instance app_
 * ver 1.2 : 24 Jun 2019
 * - minor fixes due to CodeUtilities::ProcessCmdLine changes
 * ver 1.1 : 16 Aug 2018
@@ -42,7 +56,10 @@
 *
 */
 #include <vector>
+#include <cstring>
 #include "../FileSystem/FileSystem.h"
+#include "../FileSystem/NameArena.h"
+#include "../FileSystem/PathResolver.h"
 
 namespace FileSystem
 {
@@ -52,10 +69,11 @@ namespace FileSystem
   public:
     using patterns = std::vector<std::string>;
 
-    static std::string version() { return "ver 1.2"; }
+    static std::string version() { return "ver 1.6"; }
 
     DirExplorerT(const std::string& path);
 
+    void addPath(const std::string& path);
     void addPattern(const std::string& patt);
     void hideEmptyDirectories(bool hide);
     void maxItems(size_t numFiles);
@@ -71,9 +89,13 @@ namespace FileSystem
     size_t fileCount();
     size_t dirCount();
 
+    App& app();
+
   private:
+    void walk(const std::string& fpath);
+
     App app_;
-    std::string path_;
+    std::vector<std::string> paths_;  // roots, searched in order
     patterns patterns_;
     bool hideEmptyDir_ = false;
     bool showAll_ = false;      // show files in current dir even if maxItems_ has been exceeded
@@ -81,15 +103,25 @@ namespace FileSystem
     size_t dirCount_ = 0;
     size_t fileCount_ = 0;
     bool recurse_ = false;
+    NameArena files_;           // reset and refilled for each directory
+    std::string name_;          // holds current name passed to app_
+    PathResolver resolver_;     // current directory cached per search
   };
 
   //----< construct DirExplorerN instance with default pattern >-----
 
   template<typename App>
-  DirExplorerT<App>::DirExplorerT(const std::string& path) : path_(path)
+  DirExplorerT<App>::DirExplorerT(const std::string& path) : paths_{ path }
   {
     patterns_.push_back("*.*");
   }
+  //----< add another root to search >-------------------------------
+
+  template<typename App>
+  void DirExplorerT<App>::addPath(const std::string& path)
+  {
+    paths_.push_back(path);
+  }
   //----< add specified patterns for selecting file names >----------
 
   template<typename App>
@@ -135,7 +167,7 @@ namespace FileSystem
   {
     recurse_ = doRecurse;
   }
-  //----< start Depth First Search at path held in path_ >-----------
+  //----< start Depth First Search at each path held in paths_ >-----
 
   template<typename App>
   void DirExplorerT<App>::search()
@@ -143,7 +175,9 @@ namespace FileSystem
     if (showAllInCurrDir())
       app_.showAllInCurrDir(true);
 
-    find(path_);
+    resolver_.clear();
+    for (auto& path : paths_)
+      find(path);
   }
   //----< search for directories and their files >-------------------
   /*
@@ -152,45 +186,57 @@ namespace FileSystem
   */
   template<typename App>
   void DirExplorerT<App>::find(const std::string& path)
+  {
+    walk(resolver_.resolve(path));
+  }
+  //----< find's recursion, on paths that are already absolute >-----
+
+  template<typename App>
+  void DirExplorerT<App>::walk(const std::string& fpath)
   {
     if (done())  // stop searching
       return;
 
     bool hasFiles = false;
-    std::string fpath = FileSystem::Path::getFullFileSpec(path);
     if (!hideEmptyDir_)
       app_.doDir(fpath);
 
-    for (auto patt : patterns_)
+    for (auto& patt : patterns_)
     {
-      std::vector<std::string> files = FileSystem::Directory::getFiles(fpath, patt);
+      files_.reset();
+      FileSystem::Directory::getFiles(fpath, patt, files_);
       if (!hasFiles && hideEmptyDir_)
       {
-        if (files.size() > 0)
+        if (files_.size() > 0)
         {
           app_.doDir(fpath);
           hasFiles = true;
         }
       }
-      for (auto f : files)
+      for (size_t i = 0; i < files_.size(); ++i)
       {
-        app_.doFile(f);
+        name_.assign(files_.c_str(i), files_.length(i));
+        app_.doFile(name_);
       }
     }
 
     if (done())  // stop recursion
       return;
 
-    std::vector<std::string> dirs = FileSystem::Directory::getDirectories(fpath);
-  
-    for (auto d : dirs)
+    // dirs must survive the recursive calls below, so it is local
+
+    NameArena dirs;
+    FileSystem::Directory::getDirectories(fpath, "*.*", dirs);
+
+    for (size_t i = 0; i < dirs.size(); ++i)
     {
-      if (d == "." || d == "..")
+      const char* d = dirs.c_str(i);
+      if (std::strcmp(d, ".") == 0 || std::strcmp(d, "..") == 0)
         continue;
-      std::string dpath = fpath + "\\" + d;
+      std::string dpath = resolver_.resolve(fpath, d);
       if (recurse_)
       {
-        find(dpath);
+        walk(dpath);
       }
       else
       {
@@ -203,14 +249,21 @@ namespace FileSystem
   template<typename App>
   size_t DirExplorerT<App>::fileCount()
   {
-    return App.fileCount();
+    return app_.fileCount();
   }
   //----< return number of directories processed >-------------------
 
   template<typename App>
   size_t DirExplorerT<App>::dirCount()
   {
-    return App.dirCount();
+    return app_.dirCount();
+  }
+  //----< return application instance, e.g., to collect results >---
+
+  template<typename App>
+  App& DirExplorerT<App>::app()
+  {
+    return app_;
   }
   //----< show final counts for files and dirs >---------------------
 
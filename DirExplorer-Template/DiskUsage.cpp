@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////
+// DiskUsage.cpp - DirExplorerT application that sums directory sizes//
+// ver 1.0                                                           //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018           //
+///////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_DISKUSAGE  // only compile the following when defined
+
+#include "DiskUsage.h"
+#include "DirExplorerT.h"
+#include "../StringUtilities/StringUtilities.h"
+#include "../CodeUtilities/CodeUtilities.h"
+#include "../DateTime/DateTime.h"
+#include <iostream>
+
+using namespace Utilities;
+using namespace FileSystem;
+
+std::string customUsage()
+{
+  std::string usage;
+  usage += "\n  Command Line: [/option arg]* [/option]*";
+  usage += "\n    /P path    - relative or absolute path where processing begins";
+  usage += "\n    /n number  - number of largest directories to show, default 10";
+  usage += "\n    /s         - use single threaded DirExplorerT walk";
+  usage += "\n";
+  return usage;
+}
+
+int main(int argc, char *argv[])
+{
+  Title("Demonstrate DiskUsage, " + DirExplorerT<DiskUsage>::version());
+
+  ProcessCmdLine pcl(argc, argv);
+  pcl.usage(customUsage());
+  pcl.process();
+
+  if (pcl.parseError())
+  {
+    pcl.usage();
+    std::cout << "\n\n";
+    return 1;
+  }
+
+  size_t topN = pcl.maxItems() > 0 ? (size_t)pcl.maxItems() : 10;
+  DateTime timer;
+  timer.start();
+
+  if (pcl.hasOption('s'))
+  {
+    title("single threaded walk of " + pcl.path());
+    DirExplorerT<DiskUsage> de(pcl.path());
+    de.recurse();
+    de.app().topN(topN);
+    de.search();
+    de.app().finish();
+    de.app().show();
+    de.showStats();
+  }
+  else
+  {
+    title("parallel walk of " + pcl.path());
+    DiskUsage du = DiskUsage::scan(pcl.path(), topN);
+    du.show();
+    du.showStats();
+  }
+  timer.stop();
+  std::cout << "\n  elapsed time: " << timer.elapsedMilliseconds() << " msec";
+
+  std::cout << "\n\n";
+  return 0;
+}
+
+#endif
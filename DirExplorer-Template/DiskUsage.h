@@ -0,0 +1,350 @@
+#pragma once
+///////////////////////////////////////////////////////////////////////
+// DiskUsage.h - DirExplorerT application that sums directory sizes  //
+// ver 1.1                                                           //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018           //
+///////////////////////////////////////////////////////////////////////
+/*
+*  Package Operations:
+*  -------------------
+*  DiskUsage is an application for DirExplorerT that computes, for each
+*  directory, the cumulative number of bytes and files it contains,
+*  including all of its descendants, like the Linux du command.
+*
+*  DirExplorerT walks depth first, so when doDir is handed a path that
+*  is not below the directory at the top of DiskUsage's stack, that
+*  directory, and its subtree, are complete.  Its totals are then
+*  added to its parent and offered to a bounded heap that retains the
+*  topN largest directories.  Memory use is proportional to the depth
+*  of the tree plus topN, no matter how many entries are visited.
+*
+*  DiskUsage::scan(path, ...) expands the top levels of path, breadth
+*  first, until it has about four subtrees per thread, then walks each
+*  subtree with its own DirExplorerT on a ThreadPool and merges their
+*  results.  So a tree whose bulk sits below one child, e.g., a home
+*  directory or repository root, is still summed in parallel.
+*
+*  Public Interface:
+*  -----------------
+*  DiskUsage du = DiskUsage::scan("../..", 20);  // top 20, parallel
+*  du.show();
+*    or
+*  DirExplorerT<DiskUsage> de(path);             // single threaded
+*  de.recurse();
+*  de.search();
+*  de.app().finish();
+*  de.app().show();
+*
+*  Required Files:
+*  ---------------
+*  DiskUsage.h, DiskUsage.cpp  // DiskUsage.cpp just for testing
+*  DirExplorerT.h
+*  FileSystem.h, FileSystem.cpp
+*  FileHash.h, FileHash.cpp    // fileSize
+*  ThreadPool.h
+*
+*  Maintenance History:
+*  --------------------
+*  ver 1.1 : 19 Oct 2026
+*  - scan splits work below the first level, so one large child
+*    directory no longer walks serially
+*  ver 1.0 : 19 Oct 2026
+*  - first release
+*/
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <deque>
+#include "DirExplorerT.h"
+#include "../FileSystem/FileSystem.h"
+#include "../FileSystem/FileHash.h"
+#include "../ThreadPool/ThreadPool.h"
+
+class DiskUsage
+{
+public:
+  using Size = unsigned long long;
+
+  struct DirUsage
+  {
+    std::string path;
+    Size bytes = 0;    // bytes in files of this dir and its descendants
+    size_t files = 0;  // files in this dir and its descendants
+    size_t dirs = 0;   // descendant directories
+  };
+  using Usages = std::vector<DirUsage>;
+
+  // DirExplorerT application interface
+
+  void doFile(const std::string& filename);
+  void doDir(const std::string& dirname);
+  size_t fileCount();
+  size_t dirCount();
+  bool done();
+  void showStats();
+  void showAllInCurrDir(bool showAllFilesInCurrDir);
+  bool showAllInCurrDir();
+  void maxItems(size_t maxItems);
+
+  // disk usage results
+
+  void topN(size_t n);
+  void finish();                         // complete dirs still on stack
+  void mergeSubtree(const DiskUsage& sub);
+  DirUsage total() const;
+  Usages largest() const;                // descending by bytes
+  void show(std::ostream& out = std::cout) const;
+
+  static DiskUsage scan(const std::string& path, size_t topN = 10, size_t numThreads = 0);
+
+private:
+  void leaveUntil(const std::string& path);
+  void complete();
+  void offer(const DirUsage& usage);
+  static bool isBelow(const std::string& ancestor, const std::string& path);
+  static bool larger(const DirUsage& u1, const DirUsage& u2);
+
+  std::vector<DirUsage> stack_;  // directories on current DFS path
+  Usages top_;                   // min-heap of largest directories
+  DirUsage total_;
+  size_t topN_ = 10;
+  size_t fileCount_ = 0;
+  size_t dirCount_ = 0;
+  size_t maxItems_ = 0;
+  bool showAll_ = false;
+};
+
+//----< add file's size to the current directory >-------------------
+
+inline void DiskUsage::doFile(const std::string& filename)
+{
+  ++fileCount_;
+  if (stack_.empty())
+    return;
+  DirUsage& curr = stack_.back();
+  long long size = FileSystem::FileHash::fileSize(FileSystem::Path::fileSpec(curr.path, filename));
+  if (size > 0)
+    curr.bytes += (Size)size;
+  ++curr.files;
+}
+//----< complete dirs not above dirname, then push dirname >---------
+
+inline void DiskUsage::doDir(const std::string& dirname)
+{
+  ++dirCount_;
+  leaveUntil(dirname);
+  DirUsage usage;
+  usage.path = dirname;
+  stack_.push_back(usage);
+}
+inline size_t DiskUsage::fileCount()
+{
+  return fileCount_;
+}
+inline size_t DiskUsage::dirCount()
+{
+  return dirCount_;
+}
+inline void DiskUsage::showAllInCurrDir(bool showAllFilesInCurrDir)
+{
+  showAll_ = showAllFilesInCurrDir;
+}
+inline bool DiskUsage::showAllInCurrDir()
+{
+  return showAll_;
+}
+inline void DiskUsage::maxItems(size_t maxItems)
+{
+  maxItems_ = maxItems;
+}
+inline bool DiskUsage::done()
+{
+  return (0 < maxItems_ && maxItems_ < fileCount_);
+}
+inline void DiskUsage::topN(size_t n)
+{
+  topN_ = n;
+}
+inline DiskUsage::DirUsage DiskUsage::total() const
+{
+  return total_;
+}
+//----< is path a descendant of ancestor? >--------------------------
+
+inline bool DiskUsage::isBelow(const std::string& ancestor, const std::string& path)
+{
+  size_t len = ancestor.size();
+  if (path.size() <= len || path.compare(0, len, ancestor) != 0)
+    return false;
+  if (len > 0 && (ancestor[len - 1] == '\\' || ancestor[len - 1] == '/'))
+    return true;
+  return path[len] == '\\' || path[len] == '/';
+}
+inline bool DiskUsage::larger(const DirUsage& u1, const DirUsage& u2)
+{
+  return u1.bytes > u2.bytes;
+}
+//----< pop and complete dirs until top of stack is above path >-----
+
+inline void DiskUsage::leaveUntil(const std::string& path)
+{
+  while (!stack_.empty() && !isBelow(stack_.back().path, path))
+    complete();
+}
+//----< fold finished directory into its parent >--------------------
+
+inline void DiskUsage::complete()
+{
+  DirUsage finished = std::move(stack_.back());
+  stack_.pop_back();
+  DirUsage& parent = stack_.empty() ? total_ : stack_.back();
+  parent.bytes += finished.bytes;
+  parent.files += finished.files;
+  parent.dirs += finished.dirs + (stack_.empty() ? 0 : 1);
+  if (stack_.empty() && total_.path.empty())
+    total_.path = finished.path;
+  offer(finished);
+}
+//----< keep usage if among topN largest seen so far >---------------
+
+inline void DiskUsage::offer(const DirUsage& usage)
+{
+  if (topN_ == 0)
+    return;
+  if (top_.size() < topN_)
+  {
+    top_.push_back(usage);
+    std::push_heap(top_.begin(), top_.end(), larger);
+  }
+  else if (usage.bytes > top_.front().bytes)
+  {
+    std::pop_heap(top_.begin(), top_.end(), larger);
+    top_.back() = usage;
+    std::push_heap(top_.begin(), top_.end(), larger);
+  }
+}
+//----< complete all directories, call after search >----------------
+
+inline void DiskUsage::finish()
+{
+  while (!stack_.empty())
+    complete();
+}
+//----< add finished results for a subtree of current directory >----
+
+inline void DiskUsage::mergeSubtree(const DiskUsage& sub)
+{
+  DirUsage& parent = stack_.empty() ? total_ : stack_.back();
+  parent.bytes += sub.total_.bytes;
+  parent.files += sub.total_.files;
+  parent.dirs += sub.total_.dirs + 1;
+  for (auto& usage : sub.top_)
+    offer(usage);
+  fileCount_ += sub.fileCount_;
+  dirCount_ += sub.dirCount_;
+}
+//----< return largest directories, largest first >------------------
+
+inline DiskUsage::Usages DiskUsage::largest() const
+{
+  Usages usages = top_;
+  std::sort(usages.begin(), usages.end(), larger);
+  return usages;
+}
+//----< show final counts for files and dirs >-----------------------
+
+inline void DiskUsage::showStats()
+{
+  std::cout << "\n\n  processed " << fileCount_ << " files in " << dirCount_ << " directories";
+  std::cout << "\n  total of " << total_.bytes << " bytes in " << total_.files << " files";
+  if (done())
+  {
+    std::cout << "\n  stopped because max number of files exceeded";
+  }
+}
+//----< display largest directories >--------------------------------
+
+inline void DiskUsage::show(std::ostream& out) const
+{
+  out << "\n  " << std::setw(16) << "bytes" << std::setw(10) << "files" << "  directory";
+  for (auto& usage : largest())
+  {
+    out << "\n  " << std::setw(16) << usage.bytes << std::setw(10) << usage.files << "  " << usage.path;
+  }
+}
+//----< sum subtrees of path in parallel >---------------------------
+/*
+*  Directories nearest path are expanded, breadth first, until about
+*  four unexpanded subtrees per thread remain, so the pool can balance
+*  subtrees of very different sizes.  Each of those subtrees is then
+*  explored by its own DirExplorerT<DiskUsage> on a ThreadPool.
+*  Finally the expanded directories are replayed depth first, like
+*  DirExplorerT would visit them, merging each subtree below its
+*  parent, so totals and topN are as a serial walk computes them.
+*/
+inline DiskUsage DiskUsage::scan(const std::string& path, size_t topN, size_t numThreads)
+{
+  struct Expanded
+  {
+    std::string path;
+    std::vector<size_t> children;  // indices into expanded
+    std::vector<size_t> subtrees;  // indices into subdirs
+  };
+  std::vector<Expanded> expanded;
+  std::vector<std::string> subdirs;
+  std::deque<std::pair<size_t, std::string>> frontier;  // (parent, path)
+
+  auto expand = [&](const std::string& dirPath) {
+    size_t index = expanded.size();
+    expanded.push_back(Expanded{ dirPath, {}, {} });
+    for (auto& dir : FileSystem::Directory::getDirectories(dirPath))
+    {
+      if (dir != "." && dir != "..")
+        frontier.push_back(std::make_pair(index, FileSystem::Path::fileSpec(dirPath, dir)));
+    }
+    return index;
+  };
+  size_t threads = numThreads > 0 ? numThreads : Utilities::ThreadPool::defaultThreads();
+  expand(FileSystem::Path::getFullFileSpec(path));
+  while (!frontier.empty() && frontier.size() < 4 * threads)
+  {
+    std::pair<size_t, std::string> next = std::move(frontier.front());
+    frontier.pop_front();
+    size_t index = expand(next.second);
+    expanded[next.first].children.push_back(index);
+  }
+  for (auto& entry : frontier)
+  {
+    expanded[entry.first].subtrees.push_back(subdirs.size());
+    subdirs.push_back(std::move(entry.second));
+  }
+
+  std::vector<DiskUsage> subs(subdirs.size());
+  Utilities::parallelFor(subdirs.size(), [&subdirs, &subs, topN](size_t i) {
+    FileSystem::DirExplorerT<DiskUsage> de(subdirs[i]);
+    de.recurse();
+    de.app().topN(topN);
+    de.search();
+    de.app().finish();
+    subs[i] = std::move(de.app());
+  }, numThreads);
+
+  DiskUsage root;
+  root.topN(topN);
+  std::vector<size_t> stack{ 0 };
+  while (!stack.empty())
+  {
+    const Expanded& dir = expanded[stack.back()];
+    stack.pop_back();
+    root.doDir(dir.path);
+    for (auto& file : FileSystem::Directory::getFiles(dir.path))
+      root.doFile(file);
+    for (size_t i : dir.subtrees)
+      root.mergeSubtree(subs[i]);
+    stack.insert(stack.end(), dir.children.rbegin(), dir.children.rend());
+  }
+  root.finish();
+  return root;
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////
+// DuplicateFinder.cpp - DirExplorerT application that finds files   //
+//                       with identical contents                     //
+// ver 1.0                                                           //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018           //
+///////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_DUPLICATEFINDER  // only compile the following when defined
+
+#include "DuplicateFinder.h"
+#include "DirExplorerT.h"
+#include "../StringUtilities/StringUtilities.h"
+#include "../CodeUtilities/CodeUtilities.h"
+#include <iostream>
+
+using namespace Utilities;
+using namespace FileSystem;
+
+std::string customUsage()
+{
+  std::string usage;
+  usage += "\n  Command Line: [/option arg]* [/option]*";
+  usage += "\n    /P path    - relative or absolute path where processing begins";
+  usage += "\n    /p *.h,*.cpp - patterns selecting files to compare";
+  usage += "\n    /n number  - number of hashing threads, default one per core";
+  usage += "\n    /s         - walk directory recursively";
+  usage += "\n";
+  return usage;
+}
+
+int main(int argc, char *argv[])
+{
+  Title("Demonstrate DuplicateFinder, " + DirExplorerT<DuplicateFinder>::version());
+
+  ProcessCmdLine pcl(argc, argv);
+  pcl.usage(customUsage());
+  pcl.process();
+
+  preface("Command Line: ");
+  pcl.showCmdLine(argc, argv);
+  putline();
+
+  if (pcl.parseError())
+  {
+    pcl.usage();
+    std::cout << "\n\n";
+    return 1;
+  }
+
+  DirExplorerT<DuplicateFinder> de(pcl.path());
+
+  for (auto patt : pcl.patterns())
+  {
+    de.addPattern(patt);
+  }
+
+  if (pcl.hasOption('s'))
+  {
+    de.recurse();
+  }
+
+  if (pcl.maxItems() > 0)
+  {
+    de.app().threads(pcl.maxItems());
+  }
+
+  de.search();
+
+  DuplicateFinder::Groups groups = de.app().findDuplicates();
+  de.app().showDuplicates(groups);
+  de.showStats();
+
+  std::cout << "\n\n";
+  return 0;
+}
+
+#endif
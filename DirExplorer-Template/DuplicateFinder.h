@@ -0,0 +1,298 @@
+#pragma once
+///////////////////////////////////////////////////////////////////////
+// DuplicateFinder.h - DirExplorerT application that finds files     //
+//                     with identical contents                       //
+// ver 1.0                                                           //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018           //
+///////////////////////////////////////////////////////////////////////
+/*
+*  Package Operations:
+*  -------------------
+*  DuplicateFinder is an application for DirExplorerT.  As the explorer
+*  walks a directory tree, doFile records each file's size.  After the
+*  search completes, findDuplicates() compares files in stages, each
+*  stage only examining the survivors of the stage before:
+*  1. group by size - files with a unique size can't have duplicates
+*  2. group by a hash of the first and last blockSize bytes
+*  3. group by a hash of the entire contents, read through a mapped view
+*  Stages 2 and 3 hash files in parallel on a ThreadPool.  Most files
+*  are eliminated in stage 1 or 2, so most of the tree's bytes are never
+*  read.  Files no larger than two blocks are fully hashed in stage 2,
+*  so they skip stage 3.
+*
+*  Digests are 64 bit xxHash64 values.  Files reported as duplicates are
+*  identical except with negligible probability.
+*
+*  Public Interface:
+*  -----------------
+*  DirExplorerT<DuplicateFinder> de(path);
+*  de.recurse();
+*  de.search();
+*  DuplicateFinder::Groups groups = de.app().findDuplicates();
+*  de.app().showDuplicates(groups);
+*
+*  Required Files:
+*  ---------------
+*  DuplicateFinder.h, DuplicateFinder.cpp  // DuplicateFinder.cpp just for testing
+*  DirExplorerT.h
+*  FileSystem.h, FileSystem.cpp
+*  FileHash.h, FileHash.cpp, MappedFile.h, MappedFile.cpp
+*  ThreadPool.h
+*
+*  Maintenance History:
+*  --------------------
+*  ver 1.0 : 19 Oct 2026
+*  - first release
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include "../FileSystem/FileSystem.h"
+#include "../FileSystem/FileHash.h"
+#include "../ThreadPool/ThreadPool.h"
+
+class DuplicateFinder
+{
+public:
+  using FileSpec = std::string;
+  using Group = std::vector<FileSpec>;
+  using Groups = std::vector<Group>;
+  using Size = unsigned long long;
+  using Digest = FileSystem::FileHash::Digest;
+
+  DuplicateFinder() {}
+
+  // DirExplorerT application interface
+
+  void doFile(const std::string& filename);
+  void doDir(const std::string& dirname);
+  size_t fileCount();
+  size_t dirCount();
+  bool done();
+  void showStats();
+  void showAllInCurrDir(bool showAllFilesInCurrDir);
+  bool showAllInCurrDir();
+  void maxItems(size_t maxItems);
+
+  // configure duplicate detection
+
+  void minSize(Size bytes);         // ignore smaller files, default 1
+  void blockSize(size_t bytes);     // bytes at each end for stage 2
+  void threads(size_t numThreads);  // hashing threads, 0 => one per core
+
+  // compare recorded files, after search completes
+
+  Groups findDuplicates();
+  void showDuplicates(const Groups& groups, std::ostream& out = std::cout);
+
+private:
+  struct Candidate
+  {
+    FileSpec file;
+    Size size;
+    Digest digest;
+    bool good;
+  };
+  using Candidates = std::vector<Candidate>;
+
+  void hashCandidates(Candidates& cands, bool fullHash);
+  static void keepMatches(Candidates& cands);
+
+  std::string currDir_;
+  std::unordered_map<Size, Group> bySize_;
+  size_t fileCount_ = 0;
+  size_t dirCount_ = 0;
+  size_t maxItems_ = 0;
+  bool showAll_ = false;
+  Size minSize_ = 1;
+  size_t blockSize_ = 4096;
+  size_t threads_ = 0;
+  size_t stageCounts_[3] = { 0, 0, 0 };  // candidates entering each stage
+};
+
+//----< record file under its size >---------------------------------
+
+inline void DuplicateFinder::doFile(const std::string& filename)
+{
+  ++fileCount_;
+  if (done() && !showAll_)
+    return;
+  FileSpec fileSpec = FileSystem::Path::fileSpec(currDir_, filename);
+  long long size = FileSystem::FileHash::fileSize(fileSpec);
+  if (size < 0 || (Size)size < minSize_)
+    return;
+  bySize_[(Size)size].push_back(fileSpec);
+}
+//----< files that follow belong to this directory >-----------------
+
+inline void DuplicateFinder::doDir(const std::string& dirname)
+{
+  ++dirCount_;
+  currDir_ = dirname;
+}
+inline size_t DuplicateFinder::fileCount()
+{
+  return fileCount_;
+}
+inline size_t DuplicateFinder::dirCount()
+{
+  return dirCount_;
+}
+inline void DuplicateFinder::showAllInCurrDir(bool showAllFilesInCurrDir)
+{
+  showAll_ = showAllFilesInCurrDir;
+}
+inline bool DuplicateFinder::showAllInCurrDir()
+{
+  return showAll_;
+}
+inline void DuplicateFinder::maxItems(size_t maxItems)
+{
+  maxItems_ = maxItems;
+}
+inline bool DuplicateFinder::done()
+{
+  return (0 < maxItems_ && maxItems_ < fileCount_);
+}
+inline void DuplicateFinder::minSize(Size bytes)
+{
+  minSize_ = bytes;
+}
+inline void DuplicateFinder::blockSize(size_t bytes)
+{
+  if (bytes > 0)
+    blockSize_ = bytes;
+}
+inline void DuplicateFinder::threads(size_t numThreads)
+{
+  threads_ = numThreads;
+}
+//----< show final counts for files, dirs, and comparison stages >---
+
+inline void DuplicateFinder::showStats()
+{
+  std::cout << "\n\n  processed " << fileCount_ << " files in " << dirCount_ << " directories";
+  if (done())
+  {
+    std::cout << "\n  stopped because max number of files exceeded";
+  }
+  std::cout << "\n  candidates compared by size:      " << stageCounts_[0];
+  std::cout << "\n  candidates compared by end hash:  " << stageCounts_[1];
+  std::cout << "\n  candidates compared by full hash: " << stageCounts_[2];
+}
+//----< compute digest for each candidate in parallel >--------------
+
+inline void DuplicateFinder::hashCandidates(Candidates& cands, bool fullHash)
+{
+  size_t blockSize = blockSize_;
+  Utilities::parallelFor(cands.size(), [&cands, fullHash, blockSize](size_t i) {
+    Candidate& cand = cands[i];
+    if (fullHash)
+      cand.good = FileSystem::FileHash::hashFile(cand.file, cand.digest);
+    else
+      cand.good = FileSystem::FileHash::hashFileEnds(cand.file, blockSize, cand.digest);
+  }, threads_);
+}
+//----< keep only candidates with same size and digest as another >--
+/*
+*  Leaves cands sorted so that matching candidates are adjacent.
+*  Unreadable files are dropped.
+*/
+inline void DuplicateFinder::keepMatches(Candidates& cands)
+{
+  auto less = [](const Candidate& c1, const Candidate& c2) {
+    if (c1.size != c2.size)
+      return c1.size > c2.size;  // largest first
+    return c1.digest < c2.digest;
+  };
+  auto same = [](const Candidate& c1, const Candidate& c2) {
+    return c1.size == c2.size && c1.digest == c2.digest;
+  };
+  cands.erase(
+    std::remove_if(cands.begin(), cands.end(), [](const Candidate& c) { return !c.good; }),
+    cands.end()
+  );
+  std::sort(cands.begin(), cands.end(), less);
+
+  Candidates matches;
+  for (size_t i = 0; i < cands.size(); ++i)
+  {
+    bool matchPrev = i > 0 && same(cands[i - 1], cands[i]);
+    bool matchNext = i + 1 < cands.size() && same(cands[i], cands[i + 1]);
+    if (matchPrev || matchNext)
+      matches.push_back(std::move(cands[i]));
+  }
+  cands.swap(matches);
+}
+//----< run the size, end hash, and full hash stages >---------------
+
+inline DuplicateFinder::Groups DuplicateFinder::findDuplicates()
+{
+  // stage 1 - files with unique sizes are eliminated
+
+  Candidates cands;
+  for (auto& item : bySize_)
+  {
+    if (item.second.size() < 2)
+      continue;
+    for (auto& file : item.second)
+      cands.push_back(Candidate{ file, item.first, 0, false });
+  }
+  stageCounts_[0] = fileCount_;
+  stageCounts_[1] = cands.size();
+
+  // stage 2 - hash ends of files
+
+  hashCandidates(cands, false);
+  keepMatches(cands);
+
+  // stage 3 - hash entire contents of files too large for stage 2
+
+  Candidates small, large;
+  for (auto& cand : cands)
+  {
+    if (cand.size <= 2 * (Size)blockSize_)
+      small.push_back(std::move(cand));
+    else
+      large.push_back(std::move(cand));
+  }
+  stageCounts_[2] = large.size();
+  hashCandidates(large, true);
+  keepMatches(large);
+
+  // collect runs of matching candidates into groups
+
+  Groups groups;
+  for (Candidates* pCands : { &large, &small })
+  {
+    Candidates& matched = *pCands;
+    for (size_t i = 0; i < matched.size(); ++i)
+    {
+      if (i == 0 || matched[i - 1].size != matched[i].size || matched[i - 1].digest != matched[i].digest)
+        groups.push_back(Group());
+      groups.back().push_back(matched[i].file);
+    }
+  }
+  for (auto& group : groups)
+    std::sort(group.begin(), group.end());
+  return groups;
+}
+//----< display duplicate groups and reclaimable space >-------------
+
+inline void DuplicateFinder::showDuplicates(const Groups& groups, std::ostream& out)
+{
+  Size wasted = 0;
+  for (auto& group : groups)
+  {
+    long long size = FileSystem::FileHash::fileSize(group[0]);
+    out << "\n\n  " << group.size() << " files of " << size << " bytes:";
+    for (auto& file : group)
+      out << "\n    " << file;
+    if (size > 0)
+      wasted += (Size)size * (group.size() - 1);
+  }
+  out << "\n\n  found " << groups.size() << " groups of duplicates";
+  out << "\n  removing duplicates would free " << wasted << " bytes";
+}
@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////
+// TreeCopy.cpp - DirExplorerT application that copies a directory   //
+// ver 1.1                                                           //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018           //
+///////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_TREECOPY  // only compile the following when defined
+
+#include "TreeCopy.h"
+#include "../StringUtilities/StringUtilities.h"
+#include <iostream>
+#include <chrono>
+
+using namespace Utilities;
+using namespace FileSystem;
+
+void showResult(const TreeCopy::Result& result, double msecs)
+{
+  std::cout << "\n  copied " << result.files << " files in " << result.dirs
+    << " directories in " << msecs << " msec";
+  std::cout << "\n  " << result.errors.size() << " failures";
+  for (size_t i = 0; i < result.errors.size() && i < 3; ++i)
+    std::cout << "\n    " << result.errors[i].what();
+}
+
+int main(int argc, char *argv[])
+{
+  Title("Demonstrate TreeCopy, " + DirExplorerT<TreeCopy>::version());
+
+  std::string src = argc > 1 ? argv[1] : "../FileSystem";
+  std::string dst = argc > 2 ? argv[2] : "TreeCopyTest/copy";
+
+  title("parallel copy of " + src + " to " + dst);
+  auto start = std::chrono::steady_clock::now();
+  TreeCopy::Result result = TreeCopy::copyTree(src, dst);
+  std::chrono::duration<double, std::milli> msecs = std::chrono::steady_clock::now() - start;
+  showResult(result, msecs.count());
+  putline();
+
+  title("copy again, failing if files exist");
+  start = std::chrono::steady_clock::now();
+  result = TreeCopy::copyTree(src, dst, 0, true);
+  msecs = std::chrono::steady_clock::now() - start;
+  showResult(result, msecs.count());
+  putline();
+
+  title("copy into itself is refused");
+  result = TreeCopy::copyTree(src, Path::fileSpec(src, "inside"));
+  showResult(result, 0);
+  putline();
+
+  std::string top = argc > 2 ? dst : "TreeCopyTest";
+  title("remove " + top + " with Directory::removeTree");
+  start = std::chrono::steady_clock::now();
+  bool removed = Directory::removeTree(top);
+  msecs = std::chrono::steady_clock::now() - start;
+  std::cout << "\n  " << (removed ? "removed" : lastError().what()) << " in " << msecs.count() << " msec";
+
+  std::cout << "\n\n";
+  return 0;
+}
+
+#endif
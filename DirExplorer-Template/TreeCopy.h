@@ -0,0 +1,284 @@
+#pragma once
+///////////////////////////////////////////////////////////////////////
+// TreeCopy.h - DirExplorerT application that copies a directory tree//
+// ver 1.1                                                           //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018           //
+///////////////////////////////////////////////////////////////////////
+/*
+*  Package Operations:
+*  -------------------
+*  TreeCopy is an application for DirExplorerT that copies the tree
+*  it explores to a destination directory, like cp -r.
+*
+*  The explorer's thread creates each destination directory, in doDir,
+*  before any of its files are visited, then doFile submits a copy of
+*  each file to a ThreadPool.  Many copies are in flight at once, so
+*  the latency of opening, creating, and closing files overlaps, and
+*  File::copy does the copying in the kernel where it can.  The pool
+*  is bounded, so the explorer waits, rather than queueing the whole
+*  tree, when the workers fall behind.
+*
+*  Failures don't stop the copy.  Each is recorded, as a SystemError,
+*  in the Result returned by finish() or copyTree.  Symbolic links are
+*  copied as the files they name.
+*
+*  Public Interface:
+*  -----------------
+*  TreeCopy::Result r = TreeCopy::copyTree("../data", "/mnt/stage/data");
+*  if (!r.ok())
+*    std::cout << r.errors.front().what();
+*    or
+*  ThreadPool pool(8, 32);
+*  DirExplorerT<TreeCopy> de(src);
+*  de.recurse();
+*  de.app().start(srcRoot, dstRoot, pool);  // roots already resolved
+*  de.search();
+*  TreeCopy::Result r = de.app().finish();
+*
+*  Required Files:
+*  ---------------
+*  TreeCopy.h, TreeCopy.cpp    // TreeCopy.cpp just for testing
+*  DirExplorerT.h
+*  FileSystem.h, FileSystem.cpp
+*  ThreadPool.h
+*
+*  Maintenance History:
+*  --------------------
+*  ver 1.1 : 19 Oct 2026
+*  - copyTree creates dst's missing ancestors with Directory::createTree
+*  ver 1.0 : 19 Oct 2026
+*  - first release
+*/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cerrno>
+#include "DirExplorerT.h"
+#include "../FileSystem/FileSystem.h"
+#include "../FileSystem/PathResolver.h"
+#include "../FileSystem/PathView.h"
+#include "../ThreadPool/ThreadPool.h"
+
+class TreeCopy
+{
+public:
+  using SystemError = FileSystem::SystemError;
+
+  struct Result
+  {
+    size_t files = 0;     // files copied
+    size_t dirs = 0;      // directories visited
+    std::vector<SystemError> errors;
+    bool ok() const { return errors.empty(); }
+  };
+
+  // DirExplorerT application interface
+
+  void doFile(const std::string& filename);
+  void doDir(const std::string& dirname);
+  size_t fileCount();
+  size_t dirCount();
+  bool done();
+  void showStats();
+  void showAllInCurrDir(bool showAllFilesInCurrDir);
+  bool showAllInCurrDir();
+  void maxItems(size_t maxItems);
+
+  // copy setup and results
+
+  void start(const std::string& srcRoot, const std::string& dstRoot,
+    Utilities::ThreadPool& pool, bool failIfExists = false);
+  Result finish();                     // waits for copies in flight
+
+  static Result copyTree(const std::string& src, const std::string& dst,
+    size_t numThreads = 0, bool failIfExists = false);
+
+private:
+  void copy(const std::string& src, const std::string& dst);
+  void fail(const SystemError& error);
+  static bool isBelow(const std::string& ancestor, const std::string& path);
+
+  std::string srcRoot_;
+  std::string dstRoot_;
+  std::string currSrc_;                // directory doFile's names are in
+  std::string currDst_;                // and its copy
+  bool dirOk_ = false;                 // currDst_ exists
+  bool failIfExists_ = false;
+  Utilities::ThreadPool* pPool_ = nullptr;  // null => copy in doFile
+  std::atomic<size_t> filesCopied_{ 0 };
+  std::mutex mtx_;                     // guards errors_
+  std::vector<SystemError> errors_;
+  size_t fileCount_ = 0;
+  size_t dirCount_ = 0;
+  size_t maxItems_ = 0;
+  bool showAll_ = false;
+};
+
+//----< set roots, which must be resolved as DirExplorerT resolves >-
+
+inline void TreeCopy::start(
+  const std::string& srcRoot, const std::string& dstRoot,
+  Utilities::ThreadPool& pool, bool failIfExists
+)
+{
+  srcRoot_ = srcRoot;
+  dstRoot_ = dstRoot;
+  pPool_ = &pool;
+  failIfExists_ = failIfExists;
+}
+//----< create the copy of dirname >---------------------------------
+
+inline void TreeCopy::doDir(const std::string& dirname)
+{
+  ++dirCount_;
+  currSrc_ = dirname;
+  size_t pos = dirname.compare(0, srcRoot_.size(), srcRoot_) == 0 ? srcRoot_.size() : dirname.size();
+  while (pos < dirname.size() && FileSystem::PathResolver::isSeparator(dirname[pos]))
+    ++pos;
+  if (pos == dirname.size())
+    currDst_ = dstRoot_;
+  else
+    FileSystem::PathView::join(dstRoot_, FileSystem::PathPart(dirname.data() + pos, dirname.size() - pos), currDst_);
+
+  dirOk_ = FileSystem::Directory::create(currDst_);
+  if (!dirOk_)
+  {
+    SystemError error = FileSystem::lastError();
+    dirOk_ = FileSystem::Directory::exists(currDst_);
+    if (!dirOk_)
+      fail(error);
+  }
+}
+//----< copy filename, on a worker if there is a pool >--------------
+
+inline void TreeCopy::doFile(const std::string& filename)
+{
+  ++fileCount_;
+  if (!dirOk_)
+    return;                            // its directory's failure is recorded
+  std::string src, dst;
+  FileSystem::PathView::join(currSrc_, filename, src);
+  FileSystem::PathView::join(currDst_, filename, dst);
+  if (pPool_ == nullptr)
+  {
+    copy(src, dst);
+    return;
+  }
+  pPool_->submit([this, src = std::move(src), dst = std::move(dst)]() { copy(src, dst); });
+}
+//----< one file, run by a worker >----------------------------------
+
+inline void TreeCopy::copy(const std::string& src, const std::string& dst)
+{
+  if (FileSystem::File::copy(src, dst, failIfExists_))
+    ++filesCopied_;
+  else
+    fail(FileSystem::lastError());
+}
+inline void TreeCopy::fail(const SystemError& error)
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  errors_.push_back(error);
+}
+inline size_t TreeCopy::fileCount()
+{
+  return fileCount_;
+}
+inline size_t TreeCopy::dirCount()
+{
+  return dirCount_;
+}
+inline void TreeCopy::showAllInCurrDir(bool showAllFilesInCurrDir)
+{
+  showAll_ = showAllFilesInCurrDir;
+}
+inline bool TreeCopy::showAllInCurrDir()
+{
+  return showAll_;
+}
+inline void TreeCopy::maxItems(size_t maxItems)
+{
+  maxItems_ = maxItems;
+}
+inline bool TreeCopy::done()
+{
+  return (0 < maxItems_ && maxItems_ < fileCount_);
+}
+//----< wait for copies in flight, then report >---------------------
+
+inline TreeCopy::Result TreeCopy::finish()
+{
+  if (pPool_ != nullptr)
+    pPool_->wait();
+  Result result;
+  result.files = filesCopied_;
+  result.dirs = dirCount_;
+  std::lock_guard<std::mutex> lock(mtx_);
+  result.errors = errors_;
+  return result;
+}
+//----< show final counts for files and dirs >-----------------------
+
+inline void TreeCopy::showStats()
+{
+  std::cout << "\n\n  processed " << fileCount_ << " files in " << dirCount_ << " directories";
+  std::cout << "\n  copied " << filesCopied_ << " files to " << dstRoot_;
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!errors_.empty())
+    std::cout << "\n  " << errors_.size() << " failures, first: " << errors_.front().what();
+  if (done())
+  {
+    std::cout << "\n  stopped because max number of files exceeded";
+  }
+}
+//----< is path ancestor, or a descendant of it? >-------------------
+
+inline bool TreeCopy::isBelow(const std::string& ancestor, const std::string& path)
+{
+  size_t len = ancestor.size();
+  if (path.size() < len || path.compare(0, len, ancestor) != 0)
+    return false;
+  if (path.size() == len || (len > 0 && FileSystem::PathResolver::isSeparator(ancestor[len - 1])))
+    return true;
+  return FileSystem::PathResolver::isSeparator(path[len]);
+}
+//----< copy tree at src to dst, copying files in parallel >---------
+/*
+*  Missing ancestors of dst are created.  The pool holds at most four tasks per
+*  worker, so the explorer runs only a little ahead of the copies.
+*  dst may not be inside src, as the walk would find its own copies.
+*/
+inline TreeCopy::Result TreeCopy::copyTree(
+  const std::string& src, const std::string& dst, size_t numThreads, bool failIfExists
+)
+{
+  FileSystem::PathResolver resolver;
+  std::string srcRoot = resolver.resolve(src);
+  std::string dstRoot = resolver.resolve(dst);
+  if (isBelow(srcRoot, dstRoot))
+  {
+    Result result;
+#ifdef _WIN32
+    result.errors.push_back(SystemError(ERROR_INVALID_PARAMETER, "copyTree", dst));
+#else
+    result.errors.push_back(SystemError(EINVAL, "copyTree", dst));
+#endif
+    return result;
+  }
+  if (!FileSystem::Directory::createTree(dstRoot))
+  {
+    Result result;
+    result.errors.push_back(FileSystem::lastError());
+    return result;
+  }
+  if (numThreads == 0)
+    numThreads = Utilities::ThreadPool::defaultThreads();
+  Utilities::ThreadPool pool(numThreads, 4 * numThreads);
+  FileSystem::DirExplorerT<TreeCopy> de(srcRoot);
+  de.recurse();
+  de.app().start(srcRoot, dstRoot, pool, failIfExists);
+  de.search();
+  return de.app().finish();
+}
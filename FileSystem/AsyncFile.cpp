@@ -0,0 +1,807 @@
+/////////////////////////////////////////////////////////////////////
+// AsyncFile.cpp - many reads and writes in flight from one thread //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+
+#include "AsyncFile.h"
+#include "../ThreadPool/ThreadPool.h"
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#ifdef __NR_io_uring_setup
+#define ASYNCFILE_IO_URING
+#endif
+#endif
+#endif
+#endif
+
+using namespace FileSystem;
+
+/////////////////////////////////////////////////////////////////////
+// IoExecutor::Op - one request, owned by the executor until run
+
+struct IoExecutor::Op
+{
+  Callback done;
+  bool isWrite = false;
+  unsigned long long offset = 0;
+  char* buffer = nullptr;
+  size_t len = 0;
+  const std::string* pName = nullptr;  // file's, for error messages
+  IoResult result;
+#ifdef _WIN32
+  void* hFile = nullptr;
+#else
+  int fd = -1;
+#endif
+#ifdef ASYNCFILE_IO_URING
+  struct iovec iov;
+#endif
+};
+
+/////////////////////////////////////////////////////////////////////
+// IoExecutor::Backend - carries requests to the OS and back
+
+class IoExecutor::Backend
+{
+public:
+  virtual ~Backend() {}
+  virtual void submit(Op* pOp) = 0;
+  virtual void reap(std::deque<Op*>& ready, bool wait) = 0;  // appends completed
+};
+
+namespace
+{
+  using Op = IoExecutor::Op;
+
+  //----< blocking positioned transfer, for the thread pool >----------
+
+  void transferNow(Op* pOp)
+  {
+    size_t total = 0;
+    while (total < pOp->len)
+    {
+      size_t want = std::min<size_t>(pOp->len - total, 1u << 30);
+      unsigned long long offset = pOp->offset + total;
+#ifdef _WIN32
+      OVERLAPPED overlapped = {};
+      overlapped.Offset = (DWORD)offset;
+      overlapped.OffsetHigh = (DWORD)(offset >> 32);
+      DWORD moved = 0;
+      BOOL ok = pOp->isWrite
+        ? ::WriteFile(pOp->hFile, pOp->buffer + total, (DWORD)want, &moved, &overlapped)
+        : ::ReadFile(pOp->hFile, pOp->buffer + total, (DWORD)want, &moved, &overlapped);
+      if (!ok && ::GetLastError() != ERROR_HANDLE_EOF)
+      {
+        pOp->result.error = SystemError(::GetLastError(), pOp->isWrite ? "WriteFile" : "ReadFile", *pOp->pName);
+        break;
+      }
+#else
+      ssize_t moved = pOp->isWrite
+        ? ::pwrite(pOp->fd, pOp->buffer + total, want, (off_t)offset)
+        : ::pread(pOp->fd, pOp->buffer + total, want, (off_t)offset);
+      if (moved < 0 && errno == EINTR)
+        continue;
+      if (moved < 0)
+      {
+        pOp->result.error = SystemError(WindowsHelpers::lastSystemError(), pOp->isWrite ? "pwrite" : "pread", *pOp->pName);
+        break;
+      }
+#endif
+      if (moved == 0)
+        break;                          // end of file
+      total += (size_t)moved;
+    }
+    pOp->result.bytes = total;
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // PoolBackend - worker threads block so the caller doesn't
+
+  class PoolBackend : public IoExecutor::Backend
+  {
+  public:
+    PoolBackend(size_t numThreads) : pool_(numThreads) {}
+    ~PoolBackend() { pool_.wait(); }
+
+    void submit(Op* pOp) override
+    {
+      pool_.submit([this, pOp]() {
+        transferNow(pOp);
+        {
+          std::lock_guard<std::mutex> lock(mtx_);
+          done_.push_back(pOp);
+        }
+        completed_.notify_one();
+      });
+    }
+    void reap(std::deque<Op*>& ready, bool wait) override
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      if (wait)
+        completed_.wait(lock, [this]() { return !done_.empty(); });
+      for (Op* pOp : done_)
+        ready.push_back(pOp);
+      done_.clear();
+    }
+  private:
+    Utilities::ThreadPool pool_;
+    std::mutex mtx_;
+    std::condition_variable completed_;
+    std::vector<Op*> done_;
+  };
+
+#ifdef ASYNCFILE_IO_URING
+
+  /////////////////////////////////////////////////////////////////////
+  // UringBackend - io_uring, by system call, without liburing
+  // - requests past what the completion queue holds wait in backlog_,
+  //   so completions can't overflow, as do requests that find the
+  //   submission queue full after the kernel was asked to drain it
+  // - each submission moves at most 1 GB, like transferNow, and a short
+  //   transfer is resubmitted for the rest, so a request completes only
+  //   when done, at end of file, or on error
+
+  class UringBackend : public IoExecutor::Backend
+  {
+  public:
+    ~UringBackend();
+    bool setup(unsigned entries);
+    void submit(Op* pOp) override;
+    void reap(std::deque<Op*>& ready, bool wait) override;
+  private:
+    bool place(Op* pOp);
+    void enter(unsigned minComplete);
+
+    int fd_ = -1;
+    void* sqMap_ = MAP_FAILED;
+    void* cqMap_ = MAP_FAILED;
+    size_t sqMapSize_ = 0;
+    size_t cqMapSize_ = 0;
+    io_uring_sqe* sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesSize_ = 0;
+    unsigned* sqHead_ = nullptr;
+    unsigned* sqTail_ = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned sqEntries_ = 0;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned cqMask_ = 0;
+    unsigned cqEntries_ = 0;
+    unsigned unsubmitted_ = 0;          // in the queue, kernel not told
+    unsigned onRing_ = 0;               // submitted, not reaped
+    std::deque<Op*> backlog_;
+  };
+
+  //----< create and map the rings, false if the kernel refuses >------
+
+  bool UringBackend::setup(unsigned entries)
+  {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    fd_ = (int)::syscall(__NR_io_uring_setup, entries, &params);
+    if (fd_ < 0)
+      return false;
+
+    sqMapSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqMapSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single)
+      sqMapSize_ = cqMapSize_ = std::max(sqMapSize_, cqMapSize_);
+    sqMap_ = ::mmap(nullptr, sqMapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+    if (sqMap_ == MAP_FAILED)
+      return false;
+    cqMap_ = single ? sqMap_
+      : ::mmap(nullptr, cqMapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+    if (cqMap_ == MAP_FAILED)
+      return false;
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+      return false;
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(sqMap_);
+    sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqEntries_ = params.sq_entries;
+    char* cq = static_cast<char*>(cqMap_);
+    cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqEntries_ = params.cq_entries;
+    return true;
+  }
+
+  UringBackend::~UringBackend()
+  {
+    if (sqes_ != MAP_FAILED)
+      ::munmap(sqes_, sqesSize_);
+    if (cqMap_ != MAP_FAILED && cqMap_ != sqMap_)
+      ::munmap(cqMap_, cqMapSize_);
+    if (sqMap_ != MAP_FAILED)
+      ::munmap(sqMap_, sqMapSize_);
+    if (fd_ >= 0)
+      ::close(fd_);
+  }
+  //----< queue request, kernel is told on the next reap >-------------
+
+  void UringBackend::submit(Op* pOp)
+  {
+    if (!backlog_.empty() || onRing_ == cqEntries_ || !place(pOp))
+      backlog_.push_back(pOp);
+  }
+  //----< write request's sqe, false if the queue stays full >---------
+
+  bool UringBackend::place(Op* pOp)
+  {
+    unsigned tail = *sqTail_;
+    if (tail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) == sqEntries_)
+    {
+      enter(0);                         // full, hand it to the kernel
+      if (tail - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE) == sqEntries_)
+        return false;                   // EAGAIN or EBUSY, nothing taken
+    }
+    unsigned index = tail & sqMask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    size_t done = pOp->result.bytes;    // nonzero when resubmitted
+    pOp->iov.iov_base = pOp->buffer + done;
+    pOp->iov.iov_len = std::min<size_t>(pOp->len - done, 1u << 30);
+    sqe->opcode = pOp->isWrite ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = pOp->fd;
+    sqe->off = pOp->offset + done;
+    sqe->addr = (unsigned long long)(uintptr_t)&pOp->iov;
+    sqe->len = 1;
+    sqe->user_data = (unsigned long long)(uintptr_t)pOp;
+    sqArray_[index] = index;
+    __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+    ++unsubmitted_;
+    ++onRing_;
+    return true;
+  }
+  //----< submit queued requests, waiting for minComplete >------------
+  /*
+  *  The kernel takes everything queued, unless short of memory, when
+  *  the rest go with the next call.
+  */
+  void UringBackend::enter(unsigned minComplete)
+  {
+    for (;;)
+    {
+      unsigned flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+      long n = ::syscall(__NR_io_uring_enter, fd_, unsubmitted_, minComplete, flags, nullptr, 0);
+      if (n >= 0)
+      {
+        unsubmitted_ -= (unsigned)n;
+        return;
+      }
+      if (errno == EINTR)
+        continue;
+      if (errno == EAGAIN || errno == EBUSY)
+        return;
+      throw SystemError(WindowsHelpers::lastSystemError(), "io_uring_enter", "");
+    }
+  }
+  //----< move completed requests to ready, refill from backlog >------
+  /*
+  *  A transfer that moved some bytes but not all joins the backlog,
+  *  to go back on the ring for the rest, rather than to ready.
+  */
+
+  void UringBackend::reap(std::deque<Op*>& ready, bool wait)
+  {
+    unsigned head = *cqHead_;
+    bool waiting = wait && head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    if (unsubmitted_ > 0 || waiting)
+      enter(waiting ? 1 : 0);
+
+    unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+      io_uring_cqe* cqe = &cqes_[head & cqMask_];
+      Op* pOp = reinterpret_cast<Op*>((uintptr_t)cqe->user_data);
+      --onRing_;
+      if (cqe->res < 0)
+        pOp->result.error = SystemError((WindowsHelpers::ErrorCode)-cqe->res, pOp->isWrite ? "write" : "read", *pOp->pName);
+      else
+        pOp->result.bytes += (size_t)cqe->res;
+      if (cqe->res > 0 && pOp->result.bytes < pOp->len)
+        backlog_.push_back(pOp);        // placed below, once cqes are freed
+      else
+        ready.push_back(pOp);
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+
+    while (!backlog_.empty() && onRing_ < cqEntries_ && place(backlog_.front()))
+      backlog_.pop_front();
+  }
+
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////
+// IoExecutor
+
+//----< io_uring if asked for and the kernel allows, else threads >--
+
+IoExecutor::IoExecutor(unsigned queueDepth, backend preferred, size_t numThreads)
+  : kind_(threadPool)
+{
+  if (queueDepth == 0)
+    queueDepth = 1;
+#ifdef ASYNCFILE_IO_URING
+  if (preferred == ioUring)
+  {
+    std::unique_ptr<UringBackend> pUring(new UringBackend);
+    if (pUring->setup(queueDepth))
+    {
+      pBackend_ = std::move(pUring);
+      kind_ = ioUring;
+      return;
+    }
+  }
+#else
+  (void)preferred;
+#endif
+  if (numThreads == 0)
+    numThreads = std::min<size_t>(queueDepth, 16);
+  pBackend_.reset(new PoolBackend(numThreads));
+}
+//----< wait until the OS is done with every buffer >----------------
+
+IoExecutor::~IoExecutor()
+{
+  try
+  {
+    while (inFlight_ > 0)
+      collect(true);
+  }
+  catch (...) {}
+  for (Op* pOp : ready_)
+    delete pOp;
+}
+
+void IoExecutor::submit(Op* pOp)
+{
+  try
+  {
+    pBackend_->submit(pOp);
+  }
+  catch (...)
+  {
+    delete pOp;
+    throw;
+  }
+  ++inFlight_;
+}
+void IoExecutor::collect(bool wait)
+{
+  size_t before = ready_.size();
+  pBackend_->reap(ready_, wait && inFlight_ > 0);
+  inFlight_ -= ready_.size() - before;
+}
+//----< run callbacks of collected requests >------------------------
+/*
+*  Each is removed before its callback runs, so a callback that
+*  throws leaves the rest for the next call.
+*/
+size_t IoExecutor::dispatch()
+{
+  size_t count = 0;
+  while (!ready_.empty())
+  {
+    std::unique_ptr<Op> pOp(ready_.front());
+    ready_.pop_front();
+    Callback done = std::move(pOp->done);
+    IoResult result = std::move(pOp->result);
+    pOp.reset();
+    ++count;
+    if (done)
+      done(result);
+  }
+  return count;
+}
+size_t IoExecutor::poll()
+{
+  collect(false);
+  return dispatch();
+}
+size_t IoExecutor::runOne()
+{
+  if (ready_.empty())
+    collect(inFlight_ > 0);
+  return dispatch();
+}
+void IoExecutor::run()
+{
+  while (pending() > 0)
+    runOne();
+}
+
+/////////////////////////////////////////////////////////////////////
+// AsyncFile
+
+AsyncFile::AsyncFile(IoExecutor& executor, const std::string& fileSpec)
+  : executor_(executor), name_(fileSpec) {}
+
+AsyncFile::~AsyncFile()
+{
+  close();
+}
+
+#ifdef _WIN32
+
+//----< open, blocking, for reads or writes >------------------------
+
+bool AsyncFile::open(direction dirn, bool failIfExists)
+{
+  close();
+  pos_ = size_ = 0;
+  HANDLE hFile;
+  if (dirn == in)
+    hFile = ::CreateFileA(name_.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  else
+    hFile = ::CreateFileA(name_.c_str(), GENERIC_WRITE, 0, NULL,
+      failIfExists ? CREATE_NEW : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (hFile == INVALID_HANDLE_VALUE)
+  {
+    FileSystem::setLastError(SystemError(::GetLastError(), "CreateFileA", name_));
+    return false;
+  }
+  LARGE_INTEGER size;
+  if (::GetFileSizeEx(hFile, &size))
+    size_ = (unsigned long long)size.QuadPart;
+  hFile_ = hFile;
+  return true;
+}
+bool AsyncFile::close()
+{
+  if (hFile_ == nullptr)
+    return true;
+  bool ok = ::CloseHandle(hFile_) != 0;
+  if (!ok)
+    FileSystem::setLastError(SystemError(::GetLastError(), "CloseHandle", name_));
+  hFile_ = nullptr;
+  return ok;
+}
+bool AsyncFile::isOpen() const
+{
+  return hFile_ != nullptr;
+}
+
+#else
+
+//----< open, blocking, for reads or writes >------------------------
+
+bool AsyncFile::open(direction dirn, bool failIfExists)
+{
+  close();
+  pos_ = size_ = 0;
+  int flags = O_CLOEXEC;
+  if (dirn == in)
+    flags |= O_RDONLY;
+  else
+    flags |= O_WRONLY | O_CREAT | (failIfExists ? O_EXCL : O_TRUNC);
+  int fd = ::open(name_.c_str(), flags, 0666);
+  if (fd < 0)
+  {
+    FileSystem::setLastError(SystemError(WindowsHelpers::lastSystemError(), "open", name_));
+    return false;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) == 0)
+    size_ = (unsigned long long)st.st_size;
+  fd_ = fd;
+  return true;
+}
+bool AsyncFile::close()
+{
+  if (fd_ < 0)
+    return true;
+  bool ok = ::close(fd_) == 0;
+  if (!ok)
+    FileSystem::setLastError(SystemError(WindowsHelpers::lastSystemError(), "close", name_));
+  fd_ = -1;
+  return ok;
+}
+bool AsyncFile::isOpen() const
+{
+  return fd_ >= 0;
+}
+
+#endif
+
+//----< hand request to the executor, done runs from its poll >------
+
+void AsyncFile::transfer(bool isWrite, unsigned long long offset, char* buffer, size_t len, Callback done)
+{
+  std::unique_ptr<IoExecutor::Op> pOp(new IoExecutor::Op);
+  pOp->done = std::move(done);
+  pOp->isWrite = isWrite;
+  pOp->offset = offset;
+  pOp->buffer = buffer;
+  pOp->len = len;
+  pOp->pName = &name_;
+#ifdef _WIN32
+  pOp->hFile = hFile_;
+#else
+  pOp->fd = fd_;
+#endif
+  executor_.submit(pOp.release());
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_ASYNCFILE
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+
+struct Totals
+{
+  size_t files = 0;
+  unsigned long long bytes = 0;
+  unsigned long long byteSum = 0;   // same in any completion order
+  size_t errors = 0;
+};
+
+void add(Totals& totals, const char* data, size_t len)
+{
+  totals.bytes += len;
+  for (size_t i = 0; i < len; ++i)
+    totals.byteSum += (unsigned char)data[i];
+}
+
+void show(const std::string& label, const Totals& totals, std::chrono::steady_clock::time_point start)
+{
+  std::chrono::duration<double, std::milli> msecs = std::chrono::steady_clock::now() - start;
+  std::cout << "\n  " << label << ": " << totals.files << " files, " << totals.bytes
+    << " bytes, byte sum " << totals.byteSum << ", " << totals.errors
+    << " errors, " << msecs.count() << " msec";
+}
+
+//----< ask the kernel to forget files' cached pages >---------------
+
+void dropCached(const std::vector<std::string>& files)
+{
+#if !defined(_WIN32) && defined(POSIX_FADV_DONTNEED)
+  for (const std::string& file : files)
+  {
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+      ::fdatasync(fd);                  // dirty pages can't be dropped
+      ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      ::close(fd);
+    }
+  }
+#else
+  (void)files;
+#endif
+}
+
+//----< blocking reads, one file after another >---------------------
+
+Totals readBlocking(const std::vector<std::string>& files)
+{
+  Totals totals;
+  std::vector<char> buffer(1 << 16);
+  for (const std::string& file : files)
+  {
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+    {
+      ++totals.errors;
+      continue;
+    }
+    while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0)
+      add(totals, buffer.data(), (size_t)in.gcount());
+    ++totals.files;
+  }
+  return totals;
+}
+
+//----< callbacks, depth files in flight, each read whole >----------
+
+class CallbackReader
+{
+public:
+  CallbackReader(IoExecutor& io, const std::vector<std::string>& files)
+    : io_(io), files_(files) {}
+
+  Totals run(size_t depth)
+  {
+    for (size_t i = 0; i < depth; ++i)
+      next();
+    io_.run();
+    return totals_;
+  }
+private:
+  struct Job
+  {
+    Job(IoExecutor& io, const std::string& name) : file(io, name) {}
+    AsyncFile file;
+    std::vector<char> buffer;
+  };
+  void next()
+  {
+    while (next_ < files_.size())
+    {
+      std::shared_ptr<Job> pJob = std::make_shared<Job>(io_, files_[next_++]);
+      if (!pJob->file.open(AsyncFile::in))
+      {
+        ++totals_.errors;
+        continue;
+      }
+      pJob->buffer.resize((size_t)pJob->file.size());
+      pJob->file.read(pJob->buffer.data(), pJob->buffer.size(), [this, pJob](const IoResult& result) {
+        if (result.ok())
+        {
+          add(totals_, pJob->buffer.data(), result.bytes);
+          ++totals_.files;
+        }
+        else
+          ++totals_.errors;
+        next();
+      });
+      return;
+    }
+  }
+  IoExecutor& io_;
+  const std::vector<std::string>& files_;
+  size_t next_ = 0;
+  Totals totals_;
+};
+
+#ifdef ASYNCFILE_HAS_COROUTINES
+
+//----< one of depth coroutines, each taking files until none left >-
+
+AsyncTask readFiles(IoExecutor& io, const std::vector<std::string>& files, size_t& next, Totals& totals)
+{
+  std::vector<char> buffer(1 << 16);
+  while (next < files.size())
+  {
+    AsyncFile file(io, files[next++]);
+    if (!file.open(AsyncFile::in))
+    {
+      ++totals.errors;
+      continue;
+    }
+    for (;;)
+    {
+      IoResult result = co_await file.read(buffer.data(), buffer.size());
+      if (!result.ok())
+      {
+        ++totals.errors;
+        break;
+      }
+      add(totals, buffer.data(), result.bytes);
+      if (result.bytes < buffer.size())
+      {
+        ++totals.files;
+        break;
+      }
+    }
+  }
+}
+
+Totals readCoroutines(IoExecutor& io, const std::vector<std::string>& files, size_t depth)
+{
+  Totals totals;
+  size_t next = 0;
+  for (size_t i = 0; i < depth; ++i)
+    readFiles(io, files, next, totals);
+  io.run();
+  return totals;
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  std::cout << "\n  Testing AsyncFile";
+  std::cout << "\n ===================";
+
+  std::string dir = argc > 1 ? argv[1] : "AsyncFileTest";
+  size_t count = argc > 2 ? std::stoul(argv[2]) : 2000;
+  const size_t depth = 64;
+
+  // count small files, 1 to 16 KB, written asynchronously
+
+  Directory::createTree(dir);
+  std::vector<std::string> files;
+  {
+    IoExecutor io(depth);
+    std::vector<char> data(16 * 1024);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = (char)(i * 131 + i / 251);
+    std::deque<AsyncFile> outs;
+    size_t failed = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      files.push_back(Path::fileSpec(dir, "file" + std::to_string(i) + ".dat"));
+      outs.emplace_back(io, files.back());
+      if (!outs.back().open(AsyncFile::out))
+      {
+        ++failed;
+        continue;
+      }
+      size_t len = 1024 + (i * 7919) % (data.size() - 1024);
+      AsyncFile& out = outs.back();
+      out.write(data.data() + i % 1024, len - i % 1024, [&failed, &out](const IoResult& r) {
+        if (!r.ok())
+          ++failed;
+        out.close();
+      });
+      if (io.pending() >= depth)
+        io.runOne();
+    }
+    io.run();
+    std::cout << "\n  wrote " << count << " files to " << dir << ", " << failed << " failures";
+  }
+
+  IoExecutor uring(depth);
+  IoExecutor pooled(depth, IoExecutor::threadPool);
+  std::cout << "\n  executor uses " << (uring.kind() == IoExecutor::ioUring ? "io_uring" : "a thread pool")
+    << ", " << depth << " requests in flight\n";
+
+  dropCached(files);
+  auto start = std::chrono::steady_clock::now();
+  show("blocking reads  ", readBlocking(files), start);
+
+  dropCached(files);
+  start = std::chrono::steady_clock::now();
+  show("callbacks       ", CallbackReader(uring, files).run(depth), start);
+
+  dropCached(files);
+  start = std::chrono::steady_clock::now();
+  show("thread pool     ", CallbackReader(pooled, files).run(depth), start);
+
+#ifdef ASYNCFILE_HAS_COROUTINES
+  dropCached(files);
+  start = std::chrono::steady_clock::now();
+  show("coroutines      ", readCoroutines(uring, files, depth), start);
+#else
+  std::cout << "\n  coroutines need C++20, see Build Command";
+#endif
+
+  AsyncFile missing(uring, Path::fileSpec(dir, "missing.dat"));
+  std::cout << "\n\n  open missing file: " << (missing.open(AsyncFile::in) ? "opened - error" : lastError().what());
+
+  Directory::removeTree(dir);
+  std::cout << "\n\n";
+  return 0;
+}
+
+#endif
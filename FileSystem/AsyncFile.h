@@ -0,0 +1,287 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// AsyncFile.h - many reads and writes in flight from one thread   //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Reading thousands of small files, one blocking read after another,
+* spends most of its time waiting on the device, one request at a
+* time.  This package lets one thread keep dozens of requests in
+* flight, across many files, and handle each as it completes.
+*
+* - IoExecutor   queues reads and writes, and runs each one's
+*                completion, on the thread that calls poll(),
+*                runOne(), or run().  On Linux it uses io_uring,
+*                submitting queued requests in a batch, with one
+*                system call, each time it is polled.  Elsewhere,
+*                or where the kernel refuses io_uring, a pool of
+*                threads does blocking positioned reads and writes
+*                and posts their results back.  kind() says which.
+* - AsyncFile    a file opened, blocking, for asynchronous reads or
+*                writes through an IoExecutor.  read() and write()
+*                transfer at position(), which advances as each is
+*                issued, so several may be in flight on one file.
+*                readAt() and writeAt() take an offset.
+* - IoResult     bytes transferred, and a SystemError, code 0 on
+*                success.  Reads are short only at end of file.
+*
+* Built as C++20, where the compiler has coroutines, each operation
+* has an awaitable form, and AsyncTask is a coroutine type that runs
+* detached, resumed by the IoExecutor as its operations complete:
+*
+*   AsyncTask sum(AsyncFile& file, char* buffer, size_t size) {
+*     for (;;) {
+*       IoResult r = co_await file.read(buffer, size);
+*       ...
+*       if (!r.ok() || r.bytes < size) co_return;
+*     }
+*   }
+*
+* Public Interface:
+* -----------------
+*   IoExecutor io(64);                  // 64 requests in flight
+*   AsyncFile file(io, "data.bin");
+*   if (!file.open(AsyncFile::in))
+*     std::cout << FileSystem::lastError().what();
+*   std::vector<char> buffer((size_t)file.size());
+*   file.read(buffer.data(), buffer.size(), [&](const IoResult& r) {
+*     if (r.ok()) use(buffer.data(), r.bytes);
+*   });
+*   io.run();                           // until nothing is in flight
+*
+* Required Files:
+* ---------------
+*   AsyncFile.h, AsyncFile.cpp
+*   FileSystem.h, FileSystem.cpp        // lastError
+*   ThreadPool.h                        // executor without io_uring
+*
+* Build Command:
+* --------------
+*   cl /EHa /std:c++latest /DTEST_ASYNCFILE AsyncFile.cpp FileSystem.cpp
+*   g++ -std=c++20 -pthread -DTEST_ASYNCFILE AsyncFile.cpp FileSystem.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*
+* Notes:
+* ------
+* - An IoExecutor, and its AsyncFiles, belong to one thread.  Buffers,
+*   files, and the executor must outlive the operations using them.
+* - Opening a file is blocking.
+* - An exception escaping an AsyncTask terminates the program, as a
+*   detached task has nowhere to deliver it.
+*/
+
+#include <string>
+#include <deque>
+#include <memory>
+#include <functional>
+#include "FileSystem.h"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#include <exception>
+#define ASYNCFILE_HAS_COROUTINES
+#endif
+#endif
+
+namespace FileSystem
+{
+  /////////////////////////////////////////////////////////////////////
+  // IoResult - outcome of one read or write
+
+  struct IoResult
+  {
+    size_t bytes = 0;
+    SystemError error;                  // code 0 if it succeeded
+    bool ok() const { return error.code() == 0; }
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // IoExecutor - submits requests, runs their completions
+
+  class IoExecutor
+  {
+  public:
+    using Callback = std::function<void(const IoResult&)>;
+    enum backend { ioUring, threadPool };
+
+    IoExecutor(unsigned queueDepth = 64, backend preferred = ioUring, size_t numThreads = 0);
+    IoExecutor(const IoExecutor&) = delete;
+    IoExecutor& operator=(const IoExecutor&) = delete;
+    ~IoExecutor();                      // waits for requests, skips callbacks
+
+    backend kind() const;
+    size_t pending() const;             // not yet completed and run
+    size_t poll();                      // run completed, doesn't block
+    size_t runOne();                    // wait for one, then as poll
+    void run();                         // until nothing is pending
+
+    struct Op;
+    class Backend;
+  private:
+    friend class AsyncFile;
+    void submit(Op* pOp);
+    void collect(bool wait);
+    size_t dispatch();
+
+    std::unique_ptr<Backend> pBackend_;
+    backend kind_;
+    size_t inFlight_ = 0;               // submitted, not collected
+    std::deque<Op*> ready_;             // collected, callbacks not run
+  };
+
+  inline IoExecutor::backend IoExecutor::kind() const { return kind_; }
+  inline size_t IoExecutor::pending() const { return inFlight_ + ready_.size(); }
+
+  /////////////////////////////////////////////////////////////////////
+  // AsyncFile - a file read or written through an IoExecutor
+
+  class AsyncFile
+  {
+  public:
+    using Callback = IoExecutor::Callback;
+    enum direction { in, out };
+
+    AsyncFile(IoExecutor& executor, const std::string& fileSpec);
+    AsyncFile(const AsyncFile&) = delete;
+    AsyncFile& operator=(const AsyncFile&) = delete;
+    ~AsyncFile();
+
+    bool open(direction dirn, bool failIfExists = false);
+    bool close();                       // nothing may be in flight
+    bool isOpen() const;
+    unsigned long long size() const;    // when opened
+    unsigned long long position() const;  // where read and write go next
+    std::string name() const;
+
+    void read(char* buffer, size_t len, Callback done);
+    void readAt(unsigned long long offset, char* buffer, size_t len, Callback done);
+    void write(const char* buffer, size_t len, Callback done);
+    void writeAt(unsigned long long offset, const char* buffer, size_t len, Callback done);
+
+#ifdef ASYNCFILE_HAS_COROUTINES
+    class Awaitable;
+    Awaitable read(char* buffer, size_t len);
+    Awaitable readAt(unsigned long long offset, char* buffer, size_t len);
+    Awaitable write(const char* buffer, size_t len);
+    Awaitable writeAt(unsigned long long offset, const char* buffer, size_t len);
+#endif
+  private:
+    void transfer(bool isWrite, unsigned long long offset, char* buffer, size_t len, Callback done);
+
+    IoExecutor& executor_;
+    std::string name_;
+    unsigned long long size_ = 0;
+    unsigned long long pos_ = 0;
+#ifdef _WIN32
+    void* hFile_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+  };
+
+  inline unsigned long long AsyncFile::size() const { return size_; }
+  inline unsigned long long AsyncFile::position() const { return pos_; }
+  inline std::string AsyncFile::name() const { return name_; }
+
+  inline void AsyncFile::read(char* buffer, size_t len, Callback done)
+  {
+    unsigned long long offset = pos_;
+    pos_ += len;
+    transfer(false, offset, buffer, len, std::move(done));
+  }
+  inline void AsyncFile::readAt(unsigned long long offset, char* buffer, size_t len, Callback done)
+  {
+    transfer(false, offset, buffer, len, std::move(done));
+  }
+  inline void AsyncFile::write(const char* buffer, size_t len, Callback done)
+  {
+    unsigned long long offset = pos_;
+    pos_ += len;
+    transfer(true, offset, const_cast<char*>(buffer), len, std::move(done));
+  }
+  inline void AsyncFile::writeAt(unsigned long long offset, const char* buffer, size_t len, Callback done)
+  {
+    transfer(true, offset, const_cast<char*>(buffer), len, std::move(done));
+  }
+
+#ifdef ASYNCFILE_HAS_COROUTINES
+
+  /////////////////////////////////////////////////////////////////////
+  // AsyncFile::Awaitable - co_await yields the IoResult
+  // - the request is issued when the coroutine suspends, and resumes
+  //   it from the IoExecutor's poll
+
+  class AsyncFile::Awaitable
+  {
+  public:
+    Awaitable(AsyncFile& file, bool isWrite, unsigned long long offset, char* buffer, size_t len)
+      : file_(file), isWrite_(isWrite), offset_(offset), buffer_(buffer), len_(len) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> waiting)
+    {
+      file_.transfer(isWrite_, offset_, buffer_, len_, [this, waiting](const IoResult& result) {
+        result_ = result;
+        waiting.resume();
+      });
+    }
+    IoResult await_resume() { return std::move(result_); }
+  private:
+    AsyncFile& file_;
+    bool isWrite_;
+    unsigned long long offset_;
+    char* buffer_;
+    size_t len_;
+    IoResult result_;
+  };
+
+  inline AsyncFile::Awaitable AsyncFile::read(char* buffer, size_t len)
+  {
+    Awaitable awaitable(*this, false, pos_, buffer, len);
+    pos_ += len;
+    return awaitable;
+  }
+  inline AsyncFile::Awaitable AsyncFile::readAt(unsigned long long offset, char* buffer, size_t len)
+  {
+    return Awaitable(*this, false, offset, buffer, len);
+  }
+  inline AsyncFile::Awaitable AsyncFile::write(const char* buffer, size_t len)
+  {
+    Awaitable awaitable(*this, true, pos_, const_cast<char*>(buffer), len);
+    pos_ += len;
+    return awaitable;
+  }
+  inline AsyncFile::Awaitable AsyncFile::writeAt(unsigned long long offset, const char* buffer, size_t len)
+  {
+    return Awaitable(*this, true, offset, const_cast<char*>(buffer), len);
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // AsyncTask - coroutine that starts at once and frees itself
+
+  struct AsyncTask
+  {
+    struct promise_type
+    {
+      AsyncTask get_return_object() noexcept { return AsyncTask(); }
+      std::suspend_never initial_suspend() noexcept { return {}; }
+      std::suspend_never final_suspend() noexcept { return {}; }
+      void return_void() noexcept {}
+      void unhandled_exception() noexcept { std::terminate(); }
+    };
+  };
+
+#endif
+}
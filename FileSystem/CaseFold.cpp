@@ -0,0 +1,112 @@
+/////////////////////////////////////////////////////////////////////
+// CaseFold.cpp - test stub for CaseFold                           //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+*  CaseFold.h is header only.  This file holds its test stub.
+*/
+
+#ifdef TEST_CASEFOLD
+
+#include "CaseFold.h"
+#include <iostream>
+#include <vector>
+#include <unordered_set>
+#include <chrono>
+#include <clocale>
+#include <cctype>
+
+using namespace FileSystem;
+
+int main()
+{
+  std::cout << "\n  Testing CaseFold";
+  std::cout << "\n ==================";
+  std::setlocale(LC_CTYPE, "");
+
+  // every byte value, at every length and offset, against the C library
+
+  std::string all;
+  for (int ch = 0; ch < 256; ++ch)
+    all += (char)ch;
+  bool ok = true;
+  for (size_t start = 0; start < 40; ++start)
+  {
+    for (size_t len = 0; start + len <= all.size(); len += 7)
+    {
+      std::string lower(len, ' '), upper(len, ' ');
+      bool ascii = asciiToLower(all.data() + start, len, &lower[0]);
+      asciiToUpper(all.data() + start, len, &upper[0]);
+      bool expectAscii = true;
+      for (size_t i = 0; i < len; ++i)
+      {
+        unsigned char ch = all[start + i];
+        expectAscii = expectAscii && ch < 0x80;
+        char expectLower = ch < 0x80 ? (char)std::tolower(ch) : (char)ch;
+        char expectUpper = ch < 0x80 ? (char)std::toupper(ch) : (char)ch;
+        ok = ok && lower[i] == expectLower && upper[i] == expectUpper;
+      }
+      ok = ok && ascii == expectAscii;
+      ok = ok && equalsNoCase(lower, upper) && hashNoCase(lower.data(), len) == hashNoCase(upper.data(), len);
+    }
+  }
+  std::cout << "\n  all bytes, lengths, and offsets convert correctly: " << (ok ? "yes" : "no");
+
+  std::string ext = "CPP";
+  toLowerInPlace(ext);
+  std::cout << "\n  toLowerInPlace(\"CPP\") = " << ext;
+  std::string name;
+  toUpper("FileSystem.cpp", name);
+  std::cout << "\n  toUpper(\"FileSystem.cpp\") = " << name;
+  std::string accented = "\xC3\x89T\xC3\x89.TXT";     // "ÉTÉ.TXT" in UTF-8
+  toLowerInPlace(accented);
+  std::cout << "\n  toLowerInPlace of UTF-8 \"\xC3\x89T\xC3\x89.TXT\" = " << accented
+    << " (non-ASCII depends on locale)";
+  std::cout << "\n  equalsNoCase(\"ReadMe.TXT\", \"readme.txt\") = " << equalsNoCase("ReadMe.TXT", "readme.txt");
+  std::cout << "\n  equalsNoCase(\"ReadMe.TXT\", \"readme.tx\") = " << equalsNoCase("ReadMe.TXT", "readme.tx");
+
+  std::unordered_set<std::string, NoCaseHash, NoCaseEqual> exts{ "h", "cpp", "cs" };
+  std::cout << "\n  NoCase set holds \"CPP\": " << (exts.count("CPP") ? "yes" : "no")
+    << ", \"txt\": " << (exts.count("txt") ? "yes" : "no");
+
+  // throughput on typical path lengths
+
+  std::vector<std::string> paths;
+  for (size_t i = 0; i < 100000; ++i)
+    paths.push_back("C:\\Users\\Jim\\Repos\\Utilities\\FileSystem\\Sub" + std::to_string(i) + "\\FileName.CPP");
+  size_t bytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t rep = 0; rep < 20; ++rep)
+  {
+    for (auto& path : paths)
+    {
+      toLowerInPlace(path);
+      toUpperInPlace(path);
+      bytes += 2 * path.size();
+    }
+  }
+  std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+  std::cout << "\n  in place conversion: " << bytes / secs.count() / 1e9 << " GB/s";
+
+  bytes = 0;
+  size_t equal = 0;
+  start = std::chrono::steady_clock::now();
+  for (size_t rep = 0; rep < 20; ++rep)
+  {
+    for (size_t i = 1; i < paths.size(); ++i)
+    {
+      equal += equalsNoCase(paths[i], paths[i - 1]);
+      bytes += paths[i].size();
+    }
+  }
+  secs = std::chrono::steady_clock::now() - start;
+  std::cout << "\n  equalsNoCase: " << bytes / secs.count() / 1e9 << " GB/s, " << equal << " equal";
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
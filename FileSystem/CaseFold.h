@@ -0,0 +1,314 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// CaseFold.h - fast case conversion and case-insensitive compare  //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Case conversion for file names, extensions, and patterns, which
+* are nearly always ASCII:
+* - asciiToLower and asciiToUpper convert a buffer, in place or into
+*   another buffer, sixteen chars at a time with SSE2 on x86 and x64,
+*   and eight at a time with 64 bit word arithmetic elsewhere.  Bytes
+*   above 0x7F are copied unchanged, and the return value says if
+*   there were any.
+* - toLowerInPlace, toUpperInPlace, toLower, and toUpper take that
+*   fast path, then convert any non-ASCII chars on a slow path:
+*   CharLowerBuff/CharUpperBuff on Windows, whose narrow APIs use the
+*   ANSI code page, and towlower/towupper of decoded UTF-8 elsewhere,
+*   which follow the C library's LC_CTYPE locale.  Invalid UTF-8 is
+*   left unchanged.
+* - equalsNoCase, hashNoCase, and the NoCaseEqual and NoCaseHash
+*   functors ignore ASCII case, without building folded copies, for
+*   keys of unordered containers, e.g., extension tables.  Non-ASCII
+*   bytes must match exactly.
+*
+* Public Interface:
+* -----------------
+*   std::string ext = "CPP";
+*   toLowerInPlace(ext);                       // "cpp"
+*   std::string name;
+*   toUpper(fileName, name);                   // reuses name's capacity
+*   asciiToLower(src, len, dst);               // dst may equal src
+*   std::unordered_set<std::string, NoCaseHash, NoCaseEqual> exts{ "h", "cpp" };
+*   if (exts.count("CPP")) ...
+*
+* Required Files:
+* ---------------
+*   CaseFold.h, CaseFold.cpp       // CaseFold.cpp just for testing
+*   Transcode.h                    // POSIX slow path
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CASEFOLD_SSE2
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cwctype>
+#include "../WindowsHelpers/Transcode.h"
+#endif
+
+namespace FileSystem
+{
+  bool asciiToLower(const char* src, size_t len, char* dst);
+  bool asciiToUpper(const char* src, size_t len, char* dst);
+  void toLowerInPlace(std::string& str);
+  void toUpperInPlace(std::string& str);
+  void toLower(const std::string& src, std::string& dst);
+  void toUpper(const std::string& src, std::string& dst);
+  bool equalsNoCase(const char* first, size_t firstLen, const char* second, size_t secondLen);
+  bool equalsNoCase(const std::string& first, const std::string& second);
+  size_t hashNoCase(const char* src, size_t len);
+
+  namespace CaseFoldDetail
+  {
+    const uint64_t ones = 0x0101010101010101ull;
+    const uint64_t highBits = 0x8080808080808080ull;
+
+    //----< set 0x20 in each byte of word that is in [first, last] >--
+    /*
+    *  Bytes above 0x7F never match.  Works on all eight bytes at once.
+    */
+    inline uint64_t caseBits(uint64_t word, unsigned char first, unsigned char last)
+    {
+      uint64_t low7 = word & ~highBits;
+      uint64_t geFirst = low7 + ones * (0x80 - first);      // high bit set if >= first
+      uint64_t gtLast = low7 + ones * (0x7F - last);        // high bit set if > last
+      return ((geFirst ^ gtLast) & ~word & highBits) >> 2;
+    }
+    //----< fold one 8 byte word, or fewer, to lower case >----------
+
+    inline uint64_t lowerWord(uint64_t word)
+    {
+      return word | caseBits(word, 'A', 'Z');
+    }
+
+    inline bool isUpper(char ch) { return (unsigned char)(ch - 'A') < 26; }
+    inline bool isLower(char ch) { return (unsigned char)(ch - 'a') < 26; }
+    inline char lower(char ch) { return isUpper(ch) ? char(ch | 0x20) : ch; }
+
+    //----< ASCII case conversion, returning true if src is all ASCII >
+    /*
+    *  toUpperCase selects which conversion, and is a constant, so
+    *  each caller compiles to just one of them.
+    */
+    inline bool convertAscii(const char* src, size_t len, char* dst, bool toUpperCase)
+    {
+      size_t i = 0;
+      unsigned char seen = 0;
+#ifdef CASEFOLD_SSE2
+      const __m128i first = _mm_set1_epi8(toUpperCase ? 'a' - 1 : 'A' - 1);
+      const __m128i last = _mm_set1_epi8(toUpperCase ? 'z' + 1 : 'Z' + 1);
+      const __m128i flip = _mm_set1_epi8(0x20);
+      __m128i any = _mm_setzero_si128();
+      for (; i + 16 <= len; i += 16)
+      {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        any = _mm_or_si128(any, block);
+        __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(block, first), _mm_cmplt_epi8(block, last));
+        block = _mm_xor_si128(block, _mm_and_si128(inRange, flip));  // signed, so bytes > 0x7F are out of range
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), block);
+      }
+      if (_mm_movemask_epi8(any) != 0)
+        seen = 0x80;
+#else
+      uint64_t any = 0;
+      for (; i + 8 <= len; i += 8)
+      {
+        uint64_t word;
+        std::memcpy(&word, src + i, 8);
+        any |= word;
+        word ^= toUpperCase ? caseBits(word, 'a', 'z') : caseBits(word, 'A', 'Z');
+        std::memcpy(dst + i, &word, 8);
+      }
+      if (any & highBits)
+        seen = 0x80;
+#endif
+      for (; i < len; ++i)
+      {
+        char ch = src[i];
+        seen |= (unsigned char)ch;
+        if (toUpperCase ? isLower(ch) : isUpper(ch))
+          ch ^= 0x20;
+        dst[i] = ch;
+      }
+      return (seen & 0x80) == 0;
+    }
+    //----< convert non-ASCII chars, after the ASCII pass >----------
+
+    inline void convertOther(std::string& str, bool toUpperCase)
+    {
+      if (str.empty())
+        return;
+#ifdef _WIN32
+      if (toUpperCase)
+        ::CharUpperBuffA(&str[0], (DWORD)str.size());
+      else
+        ::CharLowerBuffA(&str[0], (DWORD)str.size());
+#else
+      size_t count = WindowsHelpers::utf32Length(str.data(), str.size());
+      if (count == WindowsHelpers::invalidUtf)
+        return;
+      std::u32string wide(count, U'\0');
+      WindowsHelpers::utf8ToUtf32(str.data(), str.size(), &wide[0]);
+      for (auto& ch : wide)
+      {
+        if (ch >= 0x80)
+          ch = (char32_t)(toUpperCase ? std::towupper((wint_t)ch) : std::towlower((wint_t)ch));
+      }
+      size_t len = WindowsHelpers::utf8Length(wide.data(), wide.size());
+      if (len == WindowsHelpers::invalidUtf)
+        return;
+      str.resize(len);
+      WindowsHelpers::utf32ToUtf8(wide.data(), wide.size(), &str[0]);
+#endif
+    }
+  }
+
+  //----< ASCII lower case of src into dst, which may be src >--------
+  /*
+  *  Returns false if src holds bytes above 0x7F, which are copied
+  *  unchanged.
+  */
+  inline bool asciiToLower(const char* src, size_t len, char* dst)
+  {
+    return CaseFoldDetail::convertAscii(src, len, dst, false);
+  }
+  //----< ASCII upper case of src into dst, which may be src >--------
+
+  inline bool asciiToUpper(const char* src, size_t len, char* dst)
+  {
+    return CaseFoldDetail::convertAscii(src, len, dst, true);
+  }
+  //----< lower case str, fast for ASCII >----------------------------
+
+  inline void toLowerInPlace(std::string& str)
+  {
+    if (!str.empty() && !asciiToLower(str.data(), str.size(), &str[0]))
+      CaseFoldDetail::convertOther(str, false);
+  }
+  //----< upper case str, fast for ASCII >----------------------------
+
+  inline void toUpperInPlace(std::string& str)
+  {
+    if (!str.empty() && !asciiToUpper(str.data(), str.size(), &str[0]))
+      CaseFoldDetail::convertOther(str, true);
+  }
+  //----< lower case of src into dst, reusing dst's capacity >--------
+
+  inline void toLower(const std::string& src, std::string& dst)
+  {
+    dst.resize(src.size());
+    if (!src.empty() && !asciiToLower(src.data(), src.size(), &dst[0]))
+      CaseFoldDetail::convertOther(dst, false);
+  }
+  //----< upper case of src into dst, reusing dst's capacity >--------
+
+  inline void toUpper(const std::string& src, std::string& dst)
+  {
+    dst.resize(src.size());
+    if (!src.empty() && !asciiToUpper(src.data(), src.size(), &dst[0]))
+      CaseFoldDetail::convertOther(dst, true);
+  }
+  //----< equal, ignoring ASCII case? >-------------------------------
+
+  inline bool equalsNoCase(const char* first, size_t firstLen, const char* second, size_t secondLen)
+  {
+    if (firstLen != secondLen)
+      return false;
+    size_t i = 0;
+#ifdef CASEFOLD_SSE2
+    const __m128i before = _mm_set1_epi8('A' - 1);
+    const __m128i after = _mm_set1_epi8('Z' + 1);
+    const __m128i flip = _mm_set1_epi8(0x20);
+    for (; i + 16 <= firstLen; i += 16)
+    {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+      __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+      a = _mm_or_si128(a, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(a, before), _mm_cmplt_epi8(a, after)), flip));
+      b = _mm_or_si128(b, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(b, before), _mm_cmplt_epi8(b, after)), flip));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF)
+        return false;
+    }
+#else
+    for (; i + 8 <= firstLen; i += 8)
+    {
+      uint64_t a, b;
+      std::memcpy(&a, first + i, 8);
+      std::memcpy(&b, second + i, 8);
+      if (CaseFoldDetail::lowerWord(a) != CaseFoldDetail::lowerWord(b))
+        return false;
+    }
+#endif
+    for (; i < firstLen; ++i)
+    {
+      if (CaseFoldDetail::lower(first[i]) != CaseFoldDetail::lower(second[i]))
+        return false;
+    }
+    return true;
+  }
+
+  inline bool equalsNoCase(const std::string& first, const std::string& second)
+  {
+    return equalsNoCase(first.data(), first.size(), second.data(), second.size());
+  }
+  //----< hash that ignores ASCII case, eight bytes at a time >-------
+
+  inline size_t hashNoCase(const char* src, size_t len)
+  {
+    uint64_t hash = 0x9E3779B97F4A7C15ull ^ len;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+      uint64_t word;
+      std::memcpy(&word, src + i, 8);
+      hash = (hash ^ CaseFoldDetail::lowerWord(word)) * 0x100000001B3ull;
+      hash ^= hash >> 29;
+    }
+    if (i < len)
+    {
+      uint64_t word = 0;
+      std::memcpy(&word, src + i, len - i);
+      hash = (hash ^ CaseFoldDetail::lowerWord(word)) * 0x100000001B3ull;
+    }
+    hash ^= hash >> 32;
+    return (size_t)hash;
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // NoCaseHash and NoCaseEqual - unordered container functors
+
+  struct NoCaseHash
+  {
+    size_t operator()(const std::string& str) const
+    {
+      return hashNoCase(str.data(), str.size());
+    }
+  };
+
+  struct NoCaseEqual
+  {
+    bool operator()(const std::string& first, const std::string& second) const
+    {
+      return equalsNoCase(first, second);
+    }
+  };
+}
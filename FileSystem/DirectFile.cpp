@@ -0,0 +1,667 @@
+/////////////////////////////////////////////////////////////////////
+// DirectFile.cpp - large sequential transfers that bypass the cache//
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+
+#include "DirectFile.h"
+#include "FileSystem.h"
+#include <new>
+#include <deque>
+#include <thread>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstdint>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace FileSystem;
+
+namespace
+{
+  const unsigned long long dropWindow = 8 << 20;  // buffered: drop cache every 8 MB
+
+  unsigned long long roundUp(unsigned long long n)
+  {
+    const unsigned long long mask = AlignedBufferPool::alignment - 1;
+    return (n + mask) & ~mask;
+  }
+}
+
+/////////////////////////////////////////////////////////////////////
+// AlignedBufferPool
+
+//----< pool of bufferSize blocks, rounded up to alignment >---------
+
+AlignedBufferPool::AlignedBufferPool(size_t bufferSize, size_t maxFree)
+  : bufferSize_((size_t)roundUp(bufferSize == 0 ? alignment : bufferSize)), maxFree_(maxFree) {}
+
+AlignedBufferPool::~AlignedBufferPool()
+{
+  for (char* pData : free_)
+    deallocate(pData);
+}
+//----< process wide pool of 1 MB buffers >--------------------------
+
+AlignedBufferPool& AlignedBufferPool::shared()
+{
+  static AlignedBufferPool pool;
+  return pool;
+}
+//----< lease a free buffer, allocating if none, throws bad_alloc >--
+
+AlignedBufferPool::Buffer AlignedBufferPool::acquire()
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!free_.empty())
+    {
+      char* pData = free_.back();
+      free_.pop_back();
+      return Buffer(this, pData, bufferSize_);
+    }
+  }
+  return Buffer(this, allocate(bufferSize_), bufferSize_);
+}
+//----< keep returned buffer for reuse, up to maxFree >--------------
+
+void AlignedBufferPool::release(char* pData)
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (free_.size() < maxFree_)
+    {
+      free_.push_back(pData);
+      return;
+    }
+  }
+  deallocate(pData);
+}
+size_t AlignedBufferPool::bufferSize() const
+{
+  return bufferSize_;
+}
+size_t AlignedBufferPool::freeCount() const
+{
+  std::lock_guard<std::mutex> lock(mtx_);
+  return free_.size();
+}
+//----< aligned allocation, C++14 has no aligned new >---------------
+
+char* AlignedBufferPool::allocate(size_t size)
+{
+#ifdef _WIN32
+  void* pData = ::_aligned_malloc(size, alignment);
+#else
+  void* pData = nullptr;
+  if (::posix_memalign(&pData, alignment, size) != 0)
+    pData = nullptr;
+#endif
+  if (pData == nullptr)
+    throw std::bad_alloc();
+  return static_cast<char*>(pData);
+}
+void AlignedBufferPool::deallocate(char* pData)
+{
+#ifdef _WIN32
+  ::_aligned_free(pData);
+#else
+  ::free(pData);
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////
+// DirectFile
+
+DirectFile::DirectFile(const std::string& fileSpec) : name_(fileSpec) {}
+
+DirectFile::~DirectFile()
+{
+  close();
+}
+//----< record failure for lastError(), returns false >--------------
+
+bool DirectFile::fail(const char* call)
+{
+  FileSystem::setLastError(SystemError(WindowsHelpers::lastSystemError(), call, name_));
+  good_ = false;
+  return false;
+}
+//----< direct transfers need aligned buffers and lengths >----------
+
+bool DirectFile::aligned(const void* buffer, size_t len) const
+{
+  if (mode_ != direct)
+    return true;
+  return ((std::uintptr_t)buffer % AlignedBufferPool::alignment) == 0
+    && len % AlignedBufferPool::alignment == 0;
+}
+
+#ifdef _WIN32
+
+//----< open for sequential reading or writing >---------------------
+
+bool DirectFile::open(direction dirn, mode mod, bool failIfExists)
+{
+  close();
+  dirn_ = dirn;
+  mode_ = mod;
+  pos_ = padded_ = flushed_ = dropped_ = 0;
+  ended_ = false;
+  DWORD flags = FILE_FLAG_SEQUENTIAL_SCAN | (mod == direct ? FILE_FLAG_NO_BUFFERING : 0);
+  HANDLE hFile;
+  if (dirn == in)
+    hFile = ::CreateFileA(name_.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+  else
+    hFile = ::CreateFileA(name_.c_str(), GENERIC_WRITE, 0, NULL,
+      failIfExists ? CREATE_NEW : CREATE_ALWAYS, flags, NULL);
+  if (hFile == INVALID_HANDLE_VALUE)
+    return fail("CreateFileA");
+  hFile_ = hFile;
+  good_ = true;
+  return true;
+}
+//----< read up to len bytes, fewer only at end of file >------------
+
+size_t DirectFile::read(char* buffer, size_t len)
+{
+  if (!good_ || dirn_ != in || ended_)
+    return 0;
+  if (!aligned(buffer, len))
+  {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    fail("read");
+    return 0;
+  }
+  size_t total = 0;
+  while (total < len)
+  {
+    DWORD want = (DWORD)((len - total) < (1u << 30) ? (len - total) : (1u << 30));
+    DWORD got = 0;
+    if (!::ReadFile(hFile_, buffer + total, want, &got, NULL))
+    {
+      fail("ReadFile");
+      return 0;
+    }
+    if (got == 0)
+      break;
+    total += got;
+    if (got < want)
+      break;              // direct reads are short only at the end
+  }
+  if (total < len)
+    ended_ = true;
+  pos_ += total;
+  return total;
+}
+//----< write len bytes, padding a short last block >----------------
+
+bool DirectFile::write(const char* buffer, size_t len)
+{
+  if (!good_ || dirn_ != out)
+    return false;
+  size_t size = len;
+  if (mode_ == direct && len % AlignedBufferPool::alignment != 0)
+    size = (size_t)roundUp(len);
+  if (ended_ || !aligned(buffer, size))
+  {
+    ::SetLastError(ERROR_INVALID_PARAMETER);
+    return fail("write");
+  }
+  size_t total = 0;
+  while (total < size)
+  {
+    DWORD want = (DWORD)((size - total) < (1u << 30) ? (size - total) : (1u << 30));
+    DWORD put = 0;
+    if (!::WriteFile(hFile_, buffer + total, want, &put, NULL))
+      return fail("WriteFile");
+    total += put;
+  }
+  pos_ += len;
+  padded_ = pos_ + (size - len);
+  ended_ = size != len;
+  return true;
+}
+//----< trim padding, then close, false if trimming failed >---------
+
+bool DirectFile::close()
+{
+  if (hFile_ == nullptr)
+    return true;
+  bool ok = true;
+  if (dirn_ == out && padded_ != pos_)
+  {
+    LARGE_INTEGER end;
+    end.QuadPart = (LONGLONG)pos_;
+    ok = ::SetFilePointerEx(hFile_, end, NULL, FILE_BEGIN) && ::SetEndOfFile(hFile_);
+    if (!ok)
+      fail("SetEndOfFile");
+  }
+  ::CloseHandle(hFile_);
+  hFile_ = nullptr;
+  good_ = false;
+  return ok;
+}
+//----< Windows has only the open flag hint >------------------------
+
+void DirectFile::dropBehind(bool) {}
+
+#else
+
+//----< open for sequential reading or writing >---------------------
+/*
+ * A file system without O_DIRECT support fails the open with EINVAL,
+ * and is opened again in buffered mode.
+ */
+bool DirectFile::open(direction dirn, mode mod, bool failIfExists)
+{
+  close();
+  dirn_ = dirn;
+  mode_ = mod;
+  pos_ = padded_ = flushed_ = dropped_ = 0;
+  ended_ = false;
+  int flags = O_CLOEXEC;
+  if (dirn == in)
+    flags |= O_RDONLY;
+  else
+    flags |= O_WRONLY | O_CREAT | (failIfExists ? O_EXCL : O_TRUNC);
+#ifdef O_DIRECT
+  if (mod == direct)
+  {
+    fd_ = ::open(name_.c_str(), flags | O_DIRECT, 0666);
+    if (fd_ < 0 && errno != EINVAL)
+      return fail("open");
+  }
+#endif
+  if (fd_ < 0)
+  {
+    mode_ = buffered;
+    fd_ = ::open(name_.c_str(), flags, 0666);
+    if (fd_ < 0)
+      return fail("open");
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+  }
+  good_ = true;
+  return true;
+}
+//----< read up to len bytes, fewer only at end of file >------------
+
+size_t DirectFile::read(char* buffer, size_t len)
+{
+  if (!good_ || dirn_ != in || ended_)
+    return 0;
+  if (!aligned(buffer, len))
+  {
+    errno = EINVAL;
+    fail("read");
+    return 0;
+  }
+  size_t total = 0;
+  while (total < len)
+  {
+    ssize_t n = ::read(fd_, buffer + total, len - total);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+    {
+      fail("read");
+      return 0;
+    }
+    if (n == 0)
+      break;
+    total += (size_t)n;
+    if (mode_ == direct && total % AlignedBufferPool::alignment != 0)
+      break;              // direct reads are short only at the end
+  }
+  if (total < len)
+    ended_ = true;
+  pos_ += total;
+  dropBehind(ended_);
+  return total;
+}
+//----< write len bytes, padding a short last block >----------------
+
+bool DirectFile::write(const char* buffer, size_t len)
+{
+  if (!good_ || dirn_ != out)
+    return false;
+  size_t size = len;
+  if (mode_ == direct && len % AlignedBufferPool::alignment != 0)
+    size = (size_t)roundUp(len);
+  if (ended_ || !aligned(buffer, size))
+  {
+    errno = EINVAL;
+    return fail("write");
+  }
+  size_t total = 0;
+  while (total < size)
+  {
+    ssize_t n = ::write(fd_, buffer + total, size - total);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      return fail("write");
+    total += (size_t)n;
+  }
+  pos_ += len;
+  padded_ = pos_ + (size - len);
+  ended_ = size != len;
+  dropBehind(false);
+  return true;
+}
+//----< trim padding, then close, false if trimming failed >---------
+
+bool DirectFile::close()
+{
+  if (fd_ < 0)
+    return true;
+  bool ok = true;
+  if (dirn_ == out && padded_ != pos_ && ::ftruncate(fd_, (off_t)pos_) != 0)
+    ok = fail("ftruncate");
+  dropBehind(true);
+  if (::close(fd_) != 0 && ok)
+    ok = fail("close");
+  fd_ = -1;
+  good_ = false;
+  return ok;
+}
+//----< buffered: drop cached pages behind the file position >-------
+/*
+ * Dirty pages can't be dropped, so for writes, writeback of each
+ * window is started, then, a window later, waited for and dropped.
+ * The writer keeps going while the disk catches up.
+ */
+void DirectFile::dropBehind(bool all)
+{
+  unsigned long long since = dirn_ == out ? flushed_ : dropped_;
+  if (mode_ != buffered || pos_ == since || (!all && pos_ - since < dropWindow))
+    return;
+  unsigned long long end = pos_;
+#ifdef __linux__
+  if (dirn_ == out)
+  {
+    ::sync_file_range(fd_, (off_t)flushed_, (off_t)(pos_ - flushed_), SYNC_FILE_RANGE_WRITE);
+    if (!all)
+      end = flushed_;                 // previous window, writeback started last time
+    if (end > dropped_)
+      ::sync_file_range(fd_, (off_t)dropped_, (off_t)(end - dropped_),
+        SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+    flushed_ = pos_;
+  }
+#endif
+#ifdef POSIX_FADV_DONTNEED
+  if (end > dropped_)
+    ::posix_fadvise(fd_, (off_t)dropped_, (off_t)(end - dropped_), POSIX_FADV_DONTNEED);
+#endif
+  dropped_ = end;
+}
+
+#endif
+
+//----< double buffered copy, reads overlap writes >-----------------
+/*
+ * A reader thread fills empty buffers and queues them, the calling
+ * thread writes queued buffers and returns them.  With numBuffers 2,
+ * one is read while the other is written.  A partial destination is
+ * removed on failure.
+ */
+bool DirectFile::copy(
+  const std::string& src, const std::string& dst, bool failIfExists,
+  AlignedBufferPool& pool, size_t numBuffers
+)
+{
+  DirectFile source(src);
+  DirectFile target(dst);
+  if (!source.open(in))
+    return false;
+  if (!target.open(out, direct, failIfExists))
+    return false;
+
+  if (numBuffers < 2)
+    numBuffers = 2;
+  std::vector<AlignedBufferPool::Buffer> buffers;
+  for (size_t i = 0; i < numBuffers; ++i)
+    buffers.push_back(pool.acquire());
+
+  struct Chunk { size_t index; size_t bytes; };
+  std::mutex mtx;
+  std::condition_variable changed;
+  std::deque<size_t> empty;
+  std::deque<Chunk> full;
+  bool stop = false;                // writer failed
+  bool readFailed = false;
+  SystemError readError;
+  for (size_t i = 0; i < numBuffers; ++i)
+    empty.push_back(i);
+
+  std::thread reader([&]() {
+    for (;;)
+    {
+      size_t index;
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        changed.wait(lock, [&]() { return stop || !empty.empty(); });
+        if (stop)
+          return;
+        index = empty.front();
+        empty.pop_front();
+      }
+      size_t bytes = source.read(buffers[index].data(), buffers[index].size());
+      bool failed = !source.good();
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (failed)
+        {
+          readFailed = true;
+          readError = FileSystem::lastError();
+        }
+        full.push_back(Chunk{ index, failed ? 0 : bytes });
+      }
+      changed.notify_all();
+      if (failed || bytes < buffers[index].size())
+        return;
+    }
+  });
+
+  bool ok = true;
+  for (;;)
+  {
+    Chunk chunk;
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      changed.wait(lock, [&]() { return !full.empty(); });
+      chunk = full.front();
+      full.pop_front();
+    }
+    if (chunk.bytes > 0 && !target.write(buffers[chunk.index].data(), chunk.bytes))
+    {
+      ok = false;
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        stop = true;
+      }
+      changed.notify_all();
+      break;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      empty.push_back(chunk.index);
+    }
+    changed.notify_all();
+    if (chunk.bytes < buffers[chunk.index].size())
+      break;
+  }
+  reader.join();
+  if (readFailed)
+  {
+    FileSystem::setLastError(readError);
+    ok = false;
+  }
+  if (ok)
+    ok = target.close();
+  if (!ok)
+  {
+    SystemError error = FileSystem::lastError();
+    target.close();
+    File::remove(dst);
+    FileSystem::setLastError(error);
+  }
+  return ok;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_DIRECTFILE
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+//----< fraction of file's pages in the page cache, -1 if unknown >--
+
+double cachedFraction(const std::string& fileSpec)
+{
+#ifdef __linux__
+  int fd = ::open(fileSpec.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || ::fstat(fd, &st) != 0 || st.st_size == 0)
+  {
+    if (fd >= 0)
+      ::close(fd);
+    return -1;
+  }
+  void* pMap = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (pMap == MAP_FAILED)
+    return -1;
+  size_t page = (size_t)::sysconf(_SC_PAGESIZE);
+  size_t pages = ((size_t)st.st_size + page - 1) / page;
+  std::vector<unsigned char> resident(pages);
+  size_t count = 0;
+  if (::mincore(pMap, (size_t)st.st_size, resident.data()) == 0)
+    for (unsigned char r : resident)
+      count += r & 1;
+  ::munmap(pMap, (size_t)st.st_size);
+  return (double)count / pages;
+#else
+  (void)fileSpec;
+  return -1;
+#endif
+}
+//----< compare two files byte by byte >-----------------------------
+
+bool sameContents(const std::string& file1, const std::string& file2)
+{
+  std::ifstream in1(file1, std::ios::binary), in2(file2, std::ios::binary);
+  std::vector<char> b1(1 << 16), b2(1 << 16);
+  while (in1 && in2)
+  {
+    in1.read(b1.data(), b1.size());
+    in2.read(b2.data(), b2.size());
+    if (in1.gcount() != in2.gcount() || !std::equal(b1.begin(), b1.begin() + in1.gcount(), b2.begin()))
+      return false;
+  }
+  return !in1 && !in2;
+}
+
+void timeCopy(const std::string& label, const std::string& src, const std::string& dst,
+  bool (*copy)(const std::string&, const std::string&))
+{
+  auto start = std::chrono::steady_clock::now();
+  bool ok = copy(src, dst);
+  std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+  int cached = (int)(100 * cachedFraction(dst));  // before comparing reads it
+  std::cout << "\n  " << label << ": " << (ok ? "" : FileSystem::lastError().what())
+    << (sameContents(src, dst) ? "same contents" : "contents differ - error")
+    << ", " << 256 / secs.count() << " MB/s, copy is " << cached << "% cached";
+  File::remove(dst);
+}
+
+int main(int argc, char* argv[])
+{
+  std::cout << "\n  Testing DirectFile";
+  std::cout << "\n ====================";
+
+  std::string dir = argc > 1 ? argv[1] : ".";
+  std::string src = Path::fileSpec(dir, "DirectFileTest.src");
+  std::string dst = Path::fileSpec(dir, "DirectFileTest.dst");
+
+  // 256 MB source, plus a short last block, written buffered
+
+  {
+    AlignedBufferPool::Buffer buffer = AlignedBufferPool::shared().acquire();
+    DirectFile out(src);
+    if (!out.open(DirectFile::out, DirectFile::buffered))
+    {
+      std::cout << "\n  " << FileSystem::lastError().what() << "\n\n";
+      return 1;
+    }
+    unsigned long long value = 0x9E3779B97F4A7C15ull;
+    for (size_t block = 0; block < 256; ++block)
+    {
+      for (size_t i = 0; i < buffer.size(); i += sizeof(value))
+      {
+        value ^= value << 13; value ^= value >> 7; value ^= value << 17;
+        *reinterpret_cast<unsigned long long*>(buffer.data() + i) = value;
+      }
+      out.write(buffer.data(), buffer.size());
+    }
+    out.write(buffer.data(), 1000);
+    out.close();
+  }
+  std::cout << "\n  wrote " << src << ", buffered with drop behind, "
+    << (int)(100 * cachedFraction(src)) << "% cached";
+
+  DirectFile probe(dst);
+  probe.open(DirectFile::out);
+  std::cout << "\n  direct mode is " << (probe.isDirect() ? "supported" : "not supported, using buffered") << " in " << dir;
+  probe.close();
+  File::remove(dst);
+
+  timeCopy("DirectFile::copy", src, dst, [](const std::string& s, const std::string& d) {
+    return DirectFile::copy(s, d);
+  });
+  timeCopy("File::copy      ", src, dst, [](const std::string& s, const std::string& d) {
+    return File::copy(s, d);
+  });
+
+  AlignedBufferPool pool(1 << 16, 2);
+  {
+    AlignedBufferPool::Buffer b1 = pool.acquire(), b2 = pool.acquire(), b3 = pool.acquire();
+    std::cout << "\n\n  pool of " << pool.bufferSize() << " byte buffers, three leased, "
+      << pool.freeCount() << " free, aligned: "
+      << (((std::uintptr_t)b1.data() | (std::uintptr_t)b2.data() | (std::uintptr_t)b3.data()) % AlignedBufferPool::alignment == 0 ? "yes" : "no");
+  }
+  std::cout << "\n  after return " << pool.freeCount() << " free, maxFree is 2";
+
+  DirectFile unaligned(src);
+  unaligned.open(DirectFile::in);
+  std::vector<char> odd(5000);
+  unaligned.read(odd.data(), odd.size());
+  std::cout << "\n  unaligned direct read " << (unaligned.good() && unaligned.isDirect() ? "accepted - error" : "refused")
+    << (unaligned.isDirect() ? std::string(": ") + FileSystem::lastError().what() : std::string(""));
+  unaligned.close();
+
+  File::remove(src);
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
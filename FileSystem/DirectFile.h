@@ -0,0 +1,223 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// DirectFile.h - large sequential transfers that bypass the cache //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* Reading or writing a multi-gigabyte file through the page cache
+* evicts everything else the host had cached, though the file's own
+* pages are never used again.  This package provides:
+*
+* - AlignedBufferPool  reusable buffers, aligned and sized for direct
+*                      I/O.  acquire() leases a Buffer, which returns
+*                      itself to the pool when destroyed.
+* - DirectFile         sequential reads or writes of whole buffers.
+*   direct mode        opens with O_DIRECT, or FILE_FLAG_NO_BUFFERING
+*                      on Windows, so data moves between the device
+*                      and the caller's buffer without being cached.
+*                      A file system that refuses O_DIRECT, tmpfs for
+*                      one, gets buffered mode instead.
+*   buffered mode      uses the cache, but tells the kernel the file
+*                      is read sequentially, posix_fadvise, and drops
+*                      pages behind the file position as it goes.
+*                      Written pages are pushed to disk first, with
+*                      sync_file_range on Linux, as dirty pages can't
+*                      be dropped.  On Windows the hint is
+*                      FILE_FLAG_SEQUENTIAL_SCAN.
+* - DirectFile::copy   double buffered copy: a reader thread fills
+*                      one buffer while the calling thread writes the
+*                      other, so reads and writes overlap.
+*
+* Direct I/O moves whole aligned blocks, so every read and write but
+* the last must be a multiple of AlignedBufferPool::alignment, from a
+* buffer aligned to it.  Pool buffers always are.  The last write may
+* be short.  It is padded to a block, and close() trims the file to
+* the bytes written.
+*
+* Public Interface:
+* -----------------
+*   DirectFile::copy("archive.tar", "/mnt/backup/archive.tar");
+*
+*   AlignedBufferPool::Buffer buffer = AlignedBufferPool::shared().acquire();
+*   DirectFile in("archive.tar");
+*   if (in.open(DirectFile::in))
+*     while (size_t n = in.read(buffer.data(), buffer.size()))
+*       send(buffer.data(), n);
+*   if (!in.good())
+*     std::cout << FileSystem::lastError().what();
+*
+* Required Files:
+* ---------------
+*   DirectFile.h, DirectFile.cpp
+*   FileSystem.h, FileSystem.cpp      // lastError
+*
+* Build Command:
+* --------------
+*   cl /EHa /DTEST_DIRECTFILE DirectFile.cpp FileSystem.cpp
+*   g++ -std=c++14 -pthread -DTEST_DIRECTFILE DirectFile.cpp FileSystem.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*
+* Notes:
+* ------
+* - Direct I/O pays off for files much larger than the cache share
+*   they'd take.  Small files are faster through the cache.
+* - copy doesn't preserve mode or times; File::copy does.
+*/
+
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace FileSystem
+{
+  /////////////////////////////////////////////////////////////////////
+  // AlignedBufferPool - reusable blocks aligned for direct I/O
+
+  class AlignedBufferPool
+  {
+  public:
+    static const size_t alignment = 4096;  // covers 512 byte and 4K sectors
+
+    class Buffer
+    {
+    public:
+      Buffer() {}
+      Buffer(Buffer&& other) noexcept;
+      Buffer& operator=(Buffer&& other) noexcept;
+      Buffer(const Buffer&) = delete;
+      Buffer& operator=(const Buffer&) = delete;
+      ~Buffer();
+
+      char* data() const { return pData_; }
+      size_t size() const { return size_; }
+      explicit operator bool() const { return pData_ != nullptr; }
+    private:
+      friend class AlignedBufferPool;
+      Buffer(AlignedBufferPool* pPool, char* pData, size_t size)
+        : pPool_(pPool), pData_(pData), size_(size) {}
+      void release();
+      AlignedBufferPool* pPool_ = nullptr;
+      char* pData_ = nullptr;
+      size_t size_ = 0;
+    };
+
+    AlignedBufferPool(size_t bufferSize = 1 << 20, size_t maxFree = 8);
+    AlignedBufferPool(const AlignedBufferPool&) = delete;
+    AlignedBufferPool& operator=(const AlignedBufferPool&) = delete;
+    ~AlignedBufferPool();             // Buffers must be returned first
+
+    Buffer acquire();                 // reuses a free buffer, or allocates
+    size_t bufferSize() const;
+    size_t freeCount() const;
+    static AlignedBufferPool& shared();  // 1 MB buffers, for the process
+  private:
+    void release(char* pData);
+    static char* allocate(size_t size);
+    static void deallocate(char* pData);
+
+    size_t bufferSize_;
+    size_t maxFree_;
+    std::vector<char*> free_;
+    mutable std::mutex mtx_;
+  };
+
+  //----< lease moves, the moved from Buffer is empty >----------------
+
+  inline AlignedBufferPool::Buffer::Buffer(Buffer&& other) noexcept
+    : pPool_(other.pPool_), pData_(other.pData_), size_(other.size_)
+  {
+    other.pPool_ = nullptr;
+    other.pData_ = nullptr;
+    other.size_ = 0;
+  }
+  inline AlignedBufferPool::Buffer& AlignedBufferPool::Buffer::operator=(Buffer&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      pPool_ = other.pPool_;
+      pData_ = other.pData_;
+      size_ = other.size_;
+      other.pPool_ = nullptr;
+      other.pData_ = nullptr;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+  inline AlignedBufferPool::Buffer::~Buffer()
+  {
+    release();
+  }
+  inline void AlignedBufferPool::Buffer::release()
+  {
+    if (pPool_ != nullptr && pData_ != nullptr)
+      pPool_->release(pData_);
+    pPool_ = nullptr;
+    pData_ = nullptr;
+    size_ = 0;
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // DirectFile - sequential whole block transfers, uncached
+
+  class DirectFile
+  {
+  public:
+    enum direction { in, out };
+    enum mode { direct, buffered };
+
+    DirectFile(const std::string& fileSpec);
+    DirectFile(const DirectFile&) = delete;
+    DirectFile& operator=(const DirectFile&) = delete;
+    ~DirectFile();
+
+    bool open(direction dirn, mode mod = direct, bool failIfExists = false);
+    size_t read(char* buffer, size_t len);         // 0 at end or on failure
+    bool write(const char* buffer, size_t len);
+    bool close();
+    bool good() const;
+    bool isDirect() const;                         // false if fell back
+    unsigned long long position() const;           // bytes transferred
+    std::string name() const;
+
+    static bool copy(
+      const std::string& src, const std::string& dst, bool failIfExists = false,
+      AlignedBufferPool& pool = AlignedBufferPool::shared(), size_t numBuffers = 2
+    );
+  private:
+    bool fail(const char* call);
+    bool aligned(const void* buffer, size_t len) const;
+    void dropBehind(bool all);
+
+    std::string name_;
+    direction dirn_ = in;
+    mode mode_ = direct;
+    bool good_ = false;
+    bool ended_ = false;              // short read or write, no more
+    unsigned long long pos_ = 0;
+    unsigned long long padded_ = 0;   // pos_ rounded up by the last write
+    unsigned long long flushed_ = 0;  // buffered out: writeback started
+    unsigned long long dropped_ = 0;  // buffered: cache dropped below
+#ifdef _WIN32
+    void* hFile_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+  };
+
+  inline bool DirectFile::good() const { return good_; }
+  inline bool DirectFile::isDirect() const { return mode_ == direct; }
+  inline unsigned long long DirectFile::position() const { return pos_; }
+  inline std::string DirectFile::name() const { return name_; }
+}
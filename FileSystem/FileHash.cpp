@@ -0,0 +1,291 @@
+/////////////////////////////////////////////////////////////////////
+// FileHash.cpp - fast non-cryptographic hashes of file contents   //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+
+#include "FileHash.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+using namespace FileSystem;
+
+namespace
+{
+  const uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+  const uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+  const uint64_t Prime3 = 0x165667B19E3779F9ULL;
+  const uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+  const uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+  inline uint64_t rotl(uint64_t x, int r)
+  {
+    return (x << r) | (x >> (64 - r));
+  }
+  //----< little-endian loads, safe for unaligned data >---------------
+
+  inline uint64_t read64(const unsigned char* p)
+  {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i)
+      v = (v << 8) | p[i];
+    return v;
+  }
+
+  inline uint32_t read32(const unsigned char* p)
+  {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+  }
+
+  inline uint64_t round(uint64_t acc, uint64_t input)
+  {
+    acc += input * Prime2;
+    acc = rotl(acc, 31);
+    return acc * Prime1;
+  }
+
+  inline uint64_t mergeRound(uint64_t acc, uint64_t val)
+  {
+    acc ^= round(0, val);
+    return acc * Prime1 + Prime4;
+  }
+}
+//----< construct hasher with seed >---------------------------------
+
+XxHash64::XxHash64(uint64_t seed)
+{
+  reset(seed);
+}
+//----< discard accumulated state >----------------------------------
+
+void XxHash64::reset(uint64_t seed)
+{
+  seed_ = seed;
+  acc_[0] = seed + Prime1 + Prime2;
+  acc_[1] = seed + Prime2;
+  acc_[2] = seed;
+  acc_[3] = seed - Prime1;
+  bufLen_ = 0;
+  totalLen_ = 0;
+}
+//----< accumulate len bytes >---------------------------------------
+
+void XxHash64::update(const void* pData, size_t len)
+{
+  const unsigned char* p = static_cast<const unsigned char*>(pData);
+  const unsigned char* pEnd = p + len;
+  totalLen_ += len;
+
+  // complete a partial stripe left by a previous update
+
+  if (bufLen_ > 0)
+  {
+    size_t fill = 32 - bufLen_;
+    if (len < fill)
+    {
+      std::memcpy(buffer_ + bufLen_, p, len);
+      bufLen_ += len;
+      return;
+    }
+    std::memcpy(buffer_ + bufLen_, p, fill);
+    p += fill;
+    for (int i = 0; i < 4; ++i)
+      acc_[i] = round(acc_[i], read64(buffer_ + 8 * i));
+    bufLen_ = 0;
+  }
+
+  // consume whole stripes directly from caller's buffer
+
+  while (pEnd - p >= 32)
+  {
+    acc_[0] = round(acc_[0], read64(p));
+    acc_[1] = round(acc_[1], read64(p + 8));
+    acc_[2] = round(acc_[2], read64(p + 16));
+    acc_[3] = round(acc_[3], read64(p + 24));
+    p += 32;
+  }
+  bufLen_ = pEnd - p;
+  if (bufLen_ > 0)
+    std::memcpy(buffer_, p, bufLen_);
+}
+//----< return hash of all bytes accumulated so far >----------------
+
+XxHash64::Digest XxHash64::digest() const
+{
+  uint64_t h;
+  if (totalLen_ >= 32)
+  {
+    h = rotl(acc_[0], 1) + rotl(acc_[1], 7) + rotl(acc_[2], 12) + rotl(acc_[3], 18);
+    for (int i = 0; i < 4; ++i)
+      h = mergeRound(h, acc_[i]);
+  }
+  else
+  {
+    h = seed_ + Prime5;
+  }
+  h += totalLen_;
+
+  const unsigned char* p = buffer_;
+  const unsigned char* pEnd = buffer_ + bufLen_;
+  while (pEnd - p >= 8)
+  {
+    h ^= round(0, read64(p));
+    h = rotl(h, 27) * Prime1 + Prime4;
+    p += 8;
+  }
+  if (pEnd - p >= 4)
+  {
+    h ^= (uint64_t)read32(p) * Prime1;
+    h = rotl(h, 23) * Prime2 + Prime3;
+    p += 4;
+  }
+  while (p < pEnd)
+  {
+    h ^= (*p) * Prime5;
+    h = rotl(h, 11) * Prime1;
+    ++p;
+  }
+  h ^= h >> 33;
+  h *= Prime2;
+  h ^= h >> 29;
+  h *= Prime3;
+  h ^= h >> 32;
+  return h;
+}
+//----< one-shot hash of a buffer >----------------------------------
+
+XxHash64::Digest XxHash64::hash(const void* pData, size_t len, uint64_t seed)
+{
+  XxHash64 hasher(seed);
+  hasher.update(pData, len);
+  return hasher.digest();
+}
+//----< size of file in bytes, -1 if not accessible >----------------
+
+long long FileHash::fileSize(const std::string& fileSpec)
+{
+#ifdef _WIN32
+  struct _stat64 st;
+  if (::_stat64(fileSpec.c_str(), &st) != 0)
+    return -1;
+#else
+  struct stat st;
+  if (::stat(fileSpec.c_str(), &st) != 0)
+    return -1;
+#endif
+  return (long long)st.st_size;
+}
+//----< hash all of a file's bytes >---------------------------------
+/*
+*  Maps the file when possible.  If mapping fails, e.g., a very large
+*  file in a 32 bit process, falls back to reading large blocks.
+*/
+bool FileHash::hashFile(const std::string& fileSpec, Digest& digest)
+{
+  {
+    MappedFile mf(fileSpec);
+    if (mf.good())
+    {
+      digest = XxHash64::hash(mf.data(), mf.size());
+      return true;
+    }
+  }
+  std::ifstream in(fileSpec, std::ios::in | std::ios::binary);
+  if (!in.good())
+    return false;
+  const size_t BufSize = 1 << 16;
+  std::vector<char> buffer(BufSize);
+  XxHash64 hasher;
+  while (in.good())
+  {
+    in.read(buffer.data(), BufSize);
+    hasher.update(buffer.data(), (size_t)in.gcount());
+  }
+  if (in.bad())
+    return false;
+  digest = hasher.digest();
+  return true;
+}
+//----< hash first and last blockSize bytes of a file >--------------
+/*
+*  Files no larger than 2*blockSize are hashed entirely, so for those
+*  this digest equals a full content hash seeded with the file size.
+*/
+bool FileHash::hashFileEnds(const std::string& fileSpec, size_t blockSize, Digest& digest)
+{
+  std::ifstream in(fileSpec, std::ios::in | std::ios::binary);
+  if (!in.good())
+    return false;
+  in.seekg(0, std::ios::end);
+  long long size = (long long)in.tellg();
+  if (size < 0)
+    return false;
+  in.seekg(0, std::ios::beg);
+
+  std::vector<char> buffer(2 * blockSize);
+  size_t count = 0;
+  if ((unsigned long long)size <= 2 * blockSize)
+  {
+    in.read(buffer.data(), size);
+    count = (size_t)in.gcount();
+  }
+  else
+  {
+    in.read(buffer.data(), blockSize);
+    in.seekg(size - (long long)blockSize, std::ios::beg);
+    in.read(buffer.data() + blockSize, blockSize);
+    count = 2 * blockSize;
+  }
+  if (in.bad() || in.fail())
+    return false;
+  digest = XxHash64::hash(buffer.data(), count, (uint64_t)size);
+  return true;
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_FILEHASH
+
+#include <iostream>
+#include <iomanip>
+
+int main(int argc, char* argv[])
+{
+  std::cout << "\n  Demonstrate FileHash";
+  std::cout << "\n ======================";
+
+  std::cout << std::hex;
+  std::cout << "\n  xxHash64(\"\")    = " << XxHash64::hash("", 0) << "  expected ef46db3751d8e999";
+  std::cout << "\n  xxHash64(\"abc\") = " << XxHash64::hash("abc", 3) << "  expected 44bc2cf5ad770999";
+
+  std::string text = "Nobody inspects the spammish repetition, and then some more text to exceed a stripe";
+  XxHash64 hasher;
+  for (size_t i = 0; i < text.size(); i += 5)
+    hasher.update(text.data() + i, text.size() - i < 5 ? text.size() - i : 5);
+  std::cout << "\n  incremental and one-shot digests "
+    << (hasher.digest() == XxHash64::hash(text.data(), text.size()) ? "agree" : "differ - error");
+
+  std::string fileSpec = argc > 1 ? argv[1] : "FileHash.cpp";
+  FileHash::Digest full, ends;
+  std::cout << std::dec << "\n\n  " << fileSpec << " has " << FileHash::fileSize(fileSpec) << " bytes";
+  if (FileHash::hashFile(fileSpec, full) && FileHash::hashFileEnds(fileSpec, 4096, ends))
+  {
+    std::cout << std::hex;
+    std::cout << "\n  full hash: " << full;
+    std::cout << "\n  ends hash: " << ends;
+    std::cout << std::dec;
+  }
+  else
+    std::cout << "\n  can't hash " << fileSpec;
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// FileHash.h - fast non-cryptographic hashes of file contents     //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides:
+* - XxHash64           incremental implementation of the xxHash64
+*                      algorithm.  Produces the same digests as the
+*                      reference implementation at xxhash.com.
+* - fileSize(f)        returns size of file f in bytes, or -1 if the
+*                      file can't be examined.
+* - hashFile(f,d)      computes d = xxHash64 of all of f's bytes, reading
+*                      through a MappedFile when possible.
+* - hashFileEnds(f,n,d) computes d = xxHash64 of the first n and last n
+*                      bytes of f, seeded with f's size.  That's a cheap
+*                      filter for files that can't be the same.
+*   Both hash functions return false if f can't be read.
+*
+* Public Interface:
+* -----------------
+*   XxHash64 hasher;
+*   hasher.update(buffer, bufLen);
+*   XxHash64::Digest d = hasher.digest();
+*
+*   FileHash::Digest d1, d2;
+*   if (FileHash::hashFile("../foobar.dat", d1)) ...
+*   if (FileHash::hashFileEnds("../foobar.dat", 4096, d2)) ...
+*
+* Required Files:
+* ---------------
+*   FileHash.h, FileHash.cpp
+*   MappedFile.h, MappedFile.cpp
+*
+* Build Command:
+* --------------
+*   cl /EHa /DTEST_FILEHASH FileHash.cpp MappedFile.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <cstdint>
+
+namespace FileSystem
+{
+  /////////////////////////////////////////////////////////////////////
+  // XxHash64 class
+  // - accepts bytes in arbitrary sized pieces via update(...)
+  // - digest() may be called at any time without disturbing state
+
+  class XxHash64
+  {
+  public:
+    using Digest = uint64_t;
+
+    XxHash64(uint64_t seed = 0);
+    void reset(uint64_t seed = 0);
+    void update(const void* pData, size_t len);
+    Digest digest() const;
+    static Digest hash(const void* pData, size_t len, uint64_t seed = 0);
+  private:
+    uint64_t acc_[4];
+    unsigned char buffer_[32];  // holds partial stripe between updates
+    size_t bufLen_ = 0;
+    uint64_t totalLen_ = 0;
+    uint64_t seed_ = 0;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // file hashing functions
+
+  namespace FileHash
+  {
+    using Digest = XxHash64::Digest;
+
+    long long fileSize(const std::string& fileSpec);
+    bool hashFile(const std::string& fileSpec, Digest& digest);
+    bool hashFileEnds(const std::string& fileSpec, size_t blockSize, Digest& digest);
+  }
+}
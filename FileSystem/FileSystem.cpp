@@ -1,6 +1,6 @@
 /////////////////////////////////////////////////////////////////////////////
 // FileSystem.cpp - Support file and directory operations                  //
-// ver 2.9                                                                 //
+// ver 3.7                                                                 //
 // ----------------------------------------------------------------------- //
 // copyright  Jim Fawcett, 2012                                           //
 // All rights granted provided that this notice is retained                //
@@ -19,10 +19,64 @@
 #include <utility>
 #include <clocale>
 #include <locale>
+#include <mutex>
 #include "FileSystem.h"
+#include "../ThreadPool/ThreadPool.h"
+#ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <fnmatch.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <linux/fs.h>      // FICLONE
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+#define FILESYSTEM_COPY_FILE_RANGE
+#endif
+#endif
+#endif
 
 using namespace FileSystem;
 
+/////////////////////////////////////////////////////////
+// per thread record of last failure
+
+namespace
+{
+  thread_local SystemError lastError_;
+
+  void recordError(const char* syscall, const std::string& path)
+  {
+    lastError_.assign(WindowsHelpers::lastSystemError(), syscall, path);
+  }
+#ifdef _WIN32
+  //----< an empty match is not a failure >--------------------------
+
+  void recordFindError(const std::string& path)
+  {
+    DWORD code = ::GetLastError();
+    if (code != ERROR_FILE_NOT_FOUND && code != ERROR_NO_MORE_FILES)
+      lastError_.assign(code, "FindFirstFileA", path);
+  }
+#endif
+}
+
+const SystemError& FileSystem::lastError()
+{
+  return lastError_;
+}
+
+void FileSystem::setLastError(const SystemError& error)
+{
+  lastError_ = error;
+}
+
 /////////////////////////////////////////////////////////
 // helper FileSystemSearch
 
@@ -35,16 +89,37 @@ public:
   std::string nextFile();
   std::string firstDirectory(const std::string& path=".", const std::string& pattern="*.*");
   std::string nextDirectory();
+  size_t appendNames(const std::string& path, const std::string& pattern, NameArena& names, bool wantDirs);
   void close();
 private:
+#ifdef _WIN32
   HANDLE hFindFile;
   WIN32_FIND_DATAA FindFileData;
   WIN32_FIND_DATAA* pFindFileData;
+#else
+  bool open(const std::string& path, const std::string& pattern);
+  const char* next(bool wantDirs);
+  DIR* pDir;
+  std::string path_;
+  std::string pattern_;
+  std::string entry_;    // path of entry whose type readdir didn't give
+#endif
 };
 
+#ifdef _WIN32
 FileSystemSearch::FileSystemSearch() : pFindFileData(&FindFileData) {}
 FileSystemSearch::~FileSystemSearch() { ::FindClose(hFindFile); }
 void FileSystemSearch::close() { ::FindClose(hFindFile); }
+#else
+FileSystemSearch::FileSystemSearch() : pDir(nullptr) {}
+FileSystemSearch::~FileSystemSearch() { close(); }
+void FileSystemSearch::close()
+{
+  if (pDir != nullptr)
+    ::closedir(pDir);
+  pDir = nullptr;
+}
+#endif
 
 //----< block constructor taking array iterators >-------------------------
 
@@ -132,6 +207,7 @@ bool File::open(direction dirn, type typ)
       pIStream->open(name_.c_str(), std::ios::in);
     if (!(*pIStream).good())
     {
+      recordError("open", name_);
       good_ = false;
       pIStream = nullptr;
       //throw std::runtime_error("\n  open for input failed in File constructor");
@@ -146,6 +222,7 @@ bool File::open(direction dirn, type typ)
       pOStream->open(name_.c_str(), std::ios::out);
     if (!(*pOStream).good())
     {
+      recordError("open", name_);
       good_ = false;
       pOStream = nullptr;
       //throw std::runtime_error("\n  open for output failed in File constructor");
@@ -340,6 +417,7 @@ void File::close()
     good_ = false;
   }
 }
+#ifdef _WIN32
 //----< file exists >--------------------------------------------------
 
 bool File::exists(const std::string& file)
@@ -350,21 +428,236 @@ bool File::exists(const std::string& file)
 
 bool File::copy(const std::string& src, const std::string& dst, bool failIfExists)
 {
-  return ::CopyFileA(src.c_str(), dst.c_str(), failIfExists) != 0;
+  if (::CopyFileA(src.c_str(), dst.c_str(), failIfExists) != 0)
+    return true;
+  recordError("CopyFileA", src);
+  return false;
 }
 //----< remove file >--------------------------------------------------
 
 bool File::remove(const std::string& file)
 {
-  return ::DeleteFileA(file.c_str()) != 0;
+  if (::DeleteFileA(file.c_str()) != 0)
+    return true;
+  recordError("DeleteFileA", file);
+  return false;
 }
+#else
+//----< file exists >--------------------------------------------------
+
+bool File::exists(const std::string& file)
+{
+  return ::access(file.c_str(), F_OK) == 0;
+}
+
+namespace
+{
+  const size_t copyBufferSize = 1 << 20;
+
+  //----< may the next, slower, way of copying succeed? >------------
+
+  bool unsupported(int code)
+  {
+    return code == ENOSYS || code == EXDEV || code == EINVAL || code == EOPNOTSUPP;
+  }
+  //----< copy count bytes at offset, returns failing call or null >--
+  /*
+   * copy_file_range and sendfile move the bytes in the kernel, without
+   * a trip through user space, and copy_file_range may share extents
+   * or copy on an NFS server.  When the kernel or file system can't do
+   * one for these two files, the next is tried, ending with pread and
+   * pwrite through a large buffer.
+   */
+  const char* copyRange(int in, int out, off_t offset, off_t count, std::vector<char>& buffer)
+  {
+#ifdef FILESYSTEM_COPY_FILE_RANGE
+    while (count > 0)
+    {
+      loff_t inPos = offset, outPos = offset;
+      ssize_t n = ::copy_file_range(in, &inPos, out, &outPos, (size_t)count, 0);
+      if (n > 0)
+      {
+        offset += n;
+        count -= n;
+        continue;
+      }
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n < 0 && !unsupported(errno))
+        return "copy_file_range";
+      break;
+    }
+#endif
+#ifdef __linux__
+    if (count > 0 && ::lseek(out, offset, SEEK_SET) == offset)
+    {
+      off_t inPos = offset;
+      while (count > 0)
+      {
+        ssize_t n = ::sendfile(out, in, &inPos, (size_t)count);
+        if (n > 0)
+        {
+          count -= n;
+          continue;
+        }
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n < 0 && !unsupported(errno))
+          return "sendfile";
+        break;
+      }
+      offset = inPos;
+    }
+#endif
+    if (count > 0 && buffer.empty())
+      buffer.resize(copyBufferSize);
+    while (count > 0)
+    {
+      size_t want = count < (off_t)buffer.size() ? (size_t)count : buffer.size();
+      ssize_t n = ::pread(in, buffer.data(), want, offset);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n < 0)
+        return "pread";
+      if (n == 0)
+        break;              // source shrank while being copied
+      for (ssize_t done = 0; done < n; )
+      {
+        ssize_t written = ::pwrite(out, buffer.data() + done, (size_t)(n - done), offset + done);
+        if (written < 0 && errno == EINTR)
+          continue;
+        if (written < 0)
+          return "pwrite";
+        done += written;
+      }
+      offset += n;
+      count -= n;
+    }
+    return nullptr;
+  }
+  //----< copy data extents of in, leaving its holes as holes >------
+
+  const char* copyExtents(int in, int out, off_t size)
+  {
+    std::vector<char> buffer;
+    off_t pos = 0;
+    while (pos < size)
+    {
+      off_t data = pos;
+      off_t hole = size;
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+      data = ::lseek(in, pos, SEEK_DATA);
+      if (data < 0 && errno == ENXIO)
+        break;              // only a hole remains
+      if (data < 0)
+        data = pos;         // file system can't say, copy everything
+      else
+      {
+        hole = ::lseek(in, data, SEEK_HOLE);
+        if (hole < 0 || hole > size)
+          hole = size;
+      }
+#endif
+      if (data >= size)
+        break;
+      if (const char* call = copyRange(in, out, data, hole - data, buffer))
+        return call;
+      pos = hole;
+    }
+    return nullptr;
+  }
+}
+//----< copy file >----------------------------------------------------
+/*
+ * A FICLONE reflink shares the source's extents, copying nothing until
+ * one of the files is written.  Otherwise each data extent is copied
+ * by copyRange.  The destination is then sized to the source, so a
+ * trailing hole is kept, and given the source's mode and times, as
+ * CopyFileA does.
+ */
+bool File::copy(const std::string& src, const std::string& dst, bool failIfExists)
+{
+  int in = ::open(src.c_str(), O_RDONLY | O_CLOEXEC);
+  if (in < 0)
+  {
+    recordError("open", src);
+    return false;
+  }
+  struct stat srcStat, dstStat;
+  const char* call = ::fstat(in, &srcStat) == 0 ? nullptr : "fstat";
+  if (call == nullptr && !S_ISREG(srcStat.st_mode))
+  {
+    errno = S_ISDIR(srcStat.st_mode) ? EISDIR : EINVAL;
+    call = "copy";
+  }
+  if (call == nullptr && ::stat(dst.c_str(), &dstStat) == 0
+    && dstStat.st_dev == srcStat.st_dev && dstStat.st_ino == srcStat.st_ino)
+  {
+    errno = EINVAL;         // opening dst would truncate src
+    call = "copy";
+  }
+  if (call != nullptr)
+  {
+    recordError(call, src);
+    ::close(in);
+    return false;
+  }
+  int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (failIfExists ? O_EXCL : O_TRUNC);
+  int out = ::open(dst.c_str(), flags, srcStat.st_mode & 07777);
+  if (out < 0)
+  {
+    recordError("open", dst);
+    ::close(in);
+    return false;
+  }
+
+  bool cloned = false;
+#ifdef FICLONE
+  cloned = ::ioctl(out, FICLONE, in) == 0;
+#endif
+  if (!cloned)
+  {
+    call = copyExtents(in, out, srcStat.st_size);
+    if (call == nullptr && ::ftruncate(out, srcStat.st_size) != 0)
+      call = "ftruncate";
+  }
+  if (call == nullptr)
+  {
+    struct timespec times[2] = { srcStat.st_atim, srcStat.st_mtim };
+    ::fchmod(out, srcStat.st_mode & 07777);
+    ::futimens(out, times);
+  }
+  if (::close(out) != 0 && call == nullptr)
+    call = "close";
+  if (call != nullptr)
+  {
+    recordError(call, dst);
+    ::unlink(dst.c_str());
+  }
+  ::close(in);
+  return call == nullptr;
+}
+//----< remove file >--------------------------------------------------
+
+bool File::remove(const std::string& file)
+{
+  if (::unlink(file.c_str()) == 0)
+    return true;
+  recordError("unlink", file);
+  return false;
+}
+#endif
+#ifdef _WIN32
 //----< constructor >--------------------------------------------------
 
 FileInfo::FileInfo(const std::string& fileSpec)
 {
   hFindFile = ::FindFirstFileA(fileSpec.c_str(), &data);
   if(hFindFile == INVALID_HANDLE_VALUE)
+  {
+    recordError("FindFirstFileA", fileSpec);
     good_ = false;
+  }
   else
     good_ = true;
 }
@@ -374,17 +667,24 @@ FileInfo::~FileInfo()
 {
   ::FindClose(hFindFile);
 }
-//----< is passed filespec valid? >------------------------------------
+#else
+//----< constructor >--------------------------------------------------
 
-bool FileInfo::good()
+FileInfo::FileInfo(const std::string& fileSpec) : name_(Path::getName(fileSpec))
 {
-  return good_;
+  good_ = ::stat(fileSpec.c_str(), &data) == 0;
+  if (!good_)
+    recordError("stat", fileSpec);
 }
-//----< return file name >---------------------------------------------
+//----< destructor >---------------------------------------------------
 
-std::string FileInfo::name() const
+FileInfo::~FileInfo() {}
+#endif
+//----< is passed filespec valid? >------------------------------------
+
+bool FileInfo::good()
 {
-  return Path::getName(data.cFileName);
+  return good_;
 }
 //----< conversion helper >--------------------------------------------
 
@@ -395,6 +695,14 @@ std::string FileInfo::intToString(long i)
   out << std::setw(2) << i;
   return out.str();
 }
+
+#ifdef _WIN32
+//----< return file name >---------------------------------------------
+
+std::string FileInfo::name() const
+{
+  return Path::getName(data.cFileName);
+}
 //----< return file date >---------------------------------------------
 
 std::string FileInfo::date(dateFormat df) const
@@ -512,6 +820,104 @@ bool FileInfo::later(const FileInfo& fi) const
   FILETIME ft2 = fi.data.ftLastWriteTime;
   return ::CompareFileTime(&ft1, &ft2) == 1;
 }
+#else
+//----< return file name >---------------------------------------------
+
+std::string FileInfo::name() const
+{
+  return name_;
+}
+//----< return file date >---------------------------------------------
+
+std::string FileInfo::date(dateFormat df) const
+{
+  std::tm tm = {};
+  ::localtime_r(&data.st_mtime, &tm);
+  std::string dateStr = intToString(tm.tm_mon + 1) + '/' + intToString(tm.tm_mday) + '/' + intToString(tm.tm_year + 1900);
+  std::string timeStr = intToString(tm.tm_hour) + ':' + intToString(tm.tm_min) + ':' + intToString(tm.tm_sec);
+  if(df == dateformat)
+    return dateStr;
+  if(df == timeformat)
+    return timeStr;
+  return dateStr + " " + timeStr;
+}
+//----< return file size >---------------------------------------------
+
+size_t FileInfo::size() const
+{
+  return (size_t)data.st_size;
+}
+//----< attributes POSIX doesn't have are false >----------------------
+
+bool FileInfo::isArchive() const { return false; }
+bool FileInfo::isCompressed() const { return false; }
+bool FileInfo::isEncrypted() const { return false; }
+bool FileInfo::isOffLine() const { return false; }
+bool FileInfo::isTemporary() const { return false; }
+
+//----< is type directory? >-------------------------------------------
+
+bool FileInfo::isDirectory() const
+{
+  return S_ISDIR(data.st_mode);
+}
+//----< is type hidden?, i.e., is it a dot file >----------------------
+
+bool FileInfo::isHidden() const
+{
+  return !name_.empty() && name_[0] == '.';
+}
+//----< is type normal? >----------------------------------------------
+
+bool FileInfo::isNormal() const
+{
+  return S_ISREG(data.st_mode);
+}
+//----< is type readonly?, i.e., writable by no one >------------------
+
+bool FileInfo::isReadOnly() const
+{
+  return (data.st_mode & (S_IWUSR | S_IWGRP | S_IWOTH)) == 0;
+}
+//----< is type system?, i.e., a device, fifo, or socket >-------------
+
+bool FileInfo::isSystem() const
+{
+  return !S_ISREG(data.st_mode) && !S_ISDIR(data.st_mode) && !S_ISLNK(data.st_mode);
+}
+//----< compare names alphabetically >---------------------------------
+
+bool FileInfo::operator<(const FileInfo& fi) const
+{
+  return name_ < fi.name_;
+}
+//----< compare names alphabetically >---------------------------------
+
+bool FileInfo::operator==(const FileInfo& fi) const
+{
+  return name_ == fi.name_;
+}
+//----< compare names alphabetically >---------------------------------
+
+bool FileInfo::operator>(const FileInfo& fi) const
+{
+  return name_ > fi.name_;
+}
+//----< compare file times >-------------------------------------------
+
+bool FileInfo::earlier(const FileInfo& fi) const
+{
+  if (data.st_mtim.tv_sec != fi.data.st_mtim.tv_sec)
+    return data.st_mtim.tv_sec < fi.data.st_mtim.tv_sec;
+  return data.st_mtim.tv_nsec < fi.data.st_mtim.tv_nsec;
+}
+//----< compare file times >-------------------------------------------
+
+bool FileInfo::later(const FileInfo& fi) const
+{
+  return fi.earlier(*this);
+}
+#endif
 //----< smaller >------------------------------------------------------
 
 bool FileInfo::smaller(const FileInfo &fi) const
@@ -529,8 +935,7 @@ bool FileInfo::larger(const FileInfo &fi) const
 std::string Path::toLower(const std::string& src)
 {
   std::string temp;
-  for(size_t i=0; i<src.length(); ++i)
-    temp += tolower(src[i]);
+  FileSystem::toLower(src, temp);
   return temp;
 }
 //----< convert string to upper case chars >---------------------------
@@ -539,119 +944,91 @@ std::string Path::toLower(const std::string& src)
 std::string Path::toUpper(const std::string& src)
 {
   std::string temp;
-  for(size_t i=0; i<src.length(); ++i)
-    temp += toupper(src[i]);
+  FileSystem::toUpper(src, temp);
   return temp;
 }
 //----< get path from fileSpec >---------------------------------------
 
 std::string Path::getName(const std::string &fileSpec, bool withExt)
 {
-  size_t pos = fileSpec.find_last_of("/");
-  if(pos >= fileSpec.length())
-  {
-    pos = fileSpec.find_last_of("\\");
-    if(pos >= fileSpec.length())
-    {
-      // no path prepended
-      if(withExt)
-        return fileSpec;
-      else
-      {
-        // remove ext
-        size_t pos = fileSpec.find(".");
-        if(pos > fileSpec.size())
-          return fileSpec;
-        return fileSpec.substr(0, pos-1);
-      }
-    }
-  }
-  if(withExt)
-    return fileSpec.substr(pos+1,fileSpec.length()-pos);
-  else
-  {
-    // remove ext
-    size_t pos2 = fileSpec.find(".", pos);
-    if(pos2 > fileSpec.size())
-      // no ext
-      return fileSpec.substr(pos+1);
-    return fileSpec.substr(pos+1, pos2-pos-1);
-  }
+  PathView view(fileSpec);
+  return withExt ? view.name().str() : view.stem().str();
 }
 //----< get extension from fileSpec >----------------------------------
   
 std::string Path::getExt(const std::string& fileSpec)
 {
-  size_t pos1 = fileSpec.find_last_of('/');
-  size_t pos2 = fileSpec.find_last_of('\\');
-  size_t pos = fileSpec.find_last_of('.');
-  // handle ../ or ..\\ with no extension
-  if(pos1 < fileSpec.length() || pos2 < fileSpec.length())
-  {
-    if(pos < min(pos1, pos2))
-      return std::string("");
-  }
-  // only . is extension delimiter
-  if(0 <= pos && pos < fileSpec.length())
-    return toLower(fileSpec.substr(pos+1,fileSpec.length()-pos));
-  return std::string("");
+  std::string ext = PathView(fileSpec).ext().str();
+  toLowerInPlace(ext);
+  return ext;
 }
 //----< get path from fileSpec >---------------------------------------
 
 std::string Path::getPath(const std::string &fileSpec)
 {
-  size_t pos = fileSpec.find_last_of("/");
-  if(pos >= fileSpec.length())
-    pos = fileSpec.find_last_of("\\");
-  if(pos >= fileSpec.length())
+  PathView view(fileSpec);
+  if(!view.hasDir())
     return ".";
-  if(fileSpec.find(".",pos+1))
-    return fileSpec.substr(0,pos+1);
-  return fileSpec;
+  return view.dirWithSeparator().str();
 }
 //----< get absoluth path from fileSpec >------------------------------
 
 std::string Path::getFullFileSpec(const std::string &fileSpec)
 {
-  const size_t BufSize = 256;
-  char buffer[BufSize];
-  char filebuffer[BufSize];  // don't use but GetFullPathName will
-  char* name = filebuffer;
-  ::GetFullPathNameA(fileSpec.c_str(),BufSize, buffer, &name);
-  return std::string(buffer);
+#ifndef _WIN32
+  return PathResolver().resolve(fileSpec);
+#else
+  std::vector<char> buffer(MAX_PATH);
+  for (;;)
+  {
+    // returns length without '\0', or, if buffer is too small, size needed
+
+    DWORD len = ::GetFullPathNameA(fileSpec.c_str(), (DWORD)buffer.size(), buffer.data(), NULL);
+    if (len == 0)
+    {
+      recordError("GetFullPathNameA", fileSpec);
+      return fileSpec;
+    }
+    if (len < buffer.size())
+      return std::string(buffer.data(), len);
+    buffer.resize(len + 1);
+  }
+#endif
 }
 //----< create file spec from path and name >--------------------------
 
 std::string Path::fileSpec(const std::string &path, const std::string &name)
 {
   std::string fs;
-  size_t len = path.size();
-  if(path[len-1] == '/' || path[len-1] == '\\')
-    fs = path + name;
-  else
-  {
-    if(path.find("/") < path.size())
-      fs = path + "/" + name;
-    else if(path.find("\\") < path.size())
-      fs = path + "\\" + name;
-    else
-      fs = path + "/" + name;
-  }
+  PathView::join(path, name, fs);
   return fs;
 }
 //----< return name of the current directory >-----------------------------
 
 std::string Directory::getCurrentDirectory()
 {
+#ifdef _WIN32
   char buffer[MAX_PATH];
   ::GetCurrentDirectoryA(MAX_PATH,buffer);
   return std::string(buffer);
+#else
+  return PathResolver().currentDirectory();
+#endif
 }
 //----< change the current directory to path >-----------------------------
 
 bool Directory::setCurrentDirectory(const std::string& path)
 {
-  return ::SetCurrentDirectoryA(path.c_str()) != 0;
+#ifdef _WIN32
+  if (::SetCurrentDirectoryA(path.c_str()) != 0)
+    return true;
+  recordError("SetCurrentDirectoryA", path);
+#else
+  if (::chdir(path.c_str()) == 0)
+    return true;
+  recordError("chdir", path);
+#endif
+  return false;
 }
 //----< get names of all the files matching pattern (path:name) >----------
 
@@ -691,33 +1068,505 @@ std::vector<std::string> Directory::getDirectories(const std::string& path, cons
   }
   return dirs;
 }
+//----< append names of files matching pattern to names >------------------
+
+size_t Directory::getFiles(const std::string& path, const std::string& pattern, NameArena& names)
+{
+  FileSystemSearch fss;
+  return fss.appendNames(path, pattern, names, false);
+}
+//----< append names of directories matching pattern to names >------------
+
+size_t Directory::getDirectories(const std::string& path, const std::string& pattern, NameArena& names)
+{
+  FileSystemSearch fss;
+  return fss.appendNames(path, pattern, names, true);
+}
 //----< create directory >-------------------------------------------------
 
 bool Directory::create(const std::string& path)
 {
-  return ::CreateDirectoryA(path.c_str(), NULL) == 0;
+#ifdef _WIN32
+  if (::CreateDirectoryA(path.c_str(), NULL) != 0)
+    return true;
+  recordError("CreateDirectoryA", path);
+#else
+  if (::mkdir(path.c_str(), 0777) == 0)
+    return true;
+  recordError("mkdir", path);
+#endif
+  return false;
 }
 //----< does directory exist? >--------------------------------------------
 
 bool Directory::exists(const std::string& path)
 {
+#ifdef _WIN32
   DWORD dwAttrib = GetFileAttributesA(path.c_str());
 
   return (dwAttrib != INVALID_FILE_ATTRIBUTES && 
          (dwAttrib & FILE_ATTRIBUTE_DIRECTORY));
+#else
+  struct stat st;
+  return ::stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+#endif
 }
 //----< remove directory >-------------------------------------------------
 
 bool Directory::remove(const std::string& path)
 {
-  return ::RemoveDirectoryA(path.c_str()) == 0;
+#ifdef _WIN32
+  if (::RemoveDirectoryA(path.c_str()) != 0)
+    return true;
+  recordError("RemoveDirectoryA", path);
+#else
+  if (::rmdir(path.c_str()) == 0)
+    return true;
+  recordError("rmdir", path);
+#endif
+  return false;
+}
+//----< create path and any missing ancestors, like mkdir -p >-------------
+/*
+ * Tries path first, so when its parent exists, the usual case, that is
+ * one call.  Otherwise it backs up a component at a time to the
+ * deepest ancestor that exists, then creates the rest going forward,
+ * never testing ancestors that were never in doubt.
+ */
+namespace
+{
+  enum class MakeDir { created, exists, noParent, failed };
+
+#ifdef _WIN32
+  const char* mkdirCall = "CreateDirectoryA";
+#else
+  const char* mkdirCall = "mkdir";
+#endif
+
+  MakeDir makeDirectory(const std::string& path)
+  {
+#ifdef _WIN32
+    if (::CreateDirectoryA(path.c_str(), NULL) != 0)
+      return MakeDir::created;
+    DWORD code = ::GetLastError();
+    if (code == ERROR_ALREADY_EXISTS)
+      return MakeDir::exists;
+    if (code == ERROR_PATH_NOT_FOUND)
+      return MakeDir::noParent;
+#else
+    if (::mkdir(path.c_str(), 0777) == 0)
+      return MakeDir::created;
+    if (errno == EEXIST)
+      return MakeDir::exists;
+    if (errno == ENOENT)
+      return MakeDir::noParent;
+#endif
+    recordError(mkdirCall, path);
+    return MakeDir::failed;
+  }
 }
+
+bool Directory::createTree(const std::string& path)
+{
+  std::string dir = path;
+  size_t root = PathResolver::rootLength(dir);
+  while (dir.size() > root && dir.size() > 1 && PathResolver::isSeparator(dir.back()))
+    dir.pop_back();
+
+  std::vector<size_t> ends;   // ends of the components still to create
+  std::string prefix = dir;
+  for (;;)
+  {
+    MakeDir result = makeDirectory(prefix);
+    if (result == MakeDir::failed)
+      return false;
+    if (result == MakeDir::created)
+      break;
+    if (result == MakeDir::exists)
+    {
+      if (prefix.size() < dir.size() || Directory::exists(dir))
+        break;
+#ifdef _WIN32
+      lastError_.assign(ERROR_ALREADY_EXISTS, mkdirCall, dir);
+#else
+      lastError_.assign(EEXIST, mkdirCall, dir);
+#endif
+      return false;                       // dir is a file
+    }
+    size_t end = prefix.size();
+    while (end > root && !PathResolver::isSeparator(prefix[end - 1]))
+      --end;
+    while (end > root && PathResolver::isSeparator(prefix[end - 1]))
+      --end;
+    if (end <= root || end == 0)
+    {
+      recordError(mkdirCall, prefix);   // no ancestor to start from
+      return false;
+    }
+    ends.push_back(prefix.size());
+    prefix.resize(end);
+  }
+  while (!ends.empty())
+  {
+    prefix.assign(dir, 0, ends.back());
+    ends.pop_back();
+    MakeDir result = makeDirectory(prefix);
+    if (result == MakeDir::failed)
+      return false;
+    if (result == MakeDir::noParent)
+    {
+      recordError(mkdirCall, prefix);   // ancestor removed meanwhile
+      return false;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////////////
+// helper TreeRemover
+// - removes the contents of a directory tree, then the tree
+// - on POSIX each entry is named relative to an open descriptor
+//   for its directory, with unlinkat and openat, so the kernel
+//   never resolves a full path, and a directory swapped for a
+//   link during the removal is never followed
+// - the first few levels are expanded on the calling thread until
+//   there are enough subtrees to keep every worker busy, then the
+//   subtrees are removed in parallel, each depth first, so each
+//   worker holds one descriptor per level
+
+namespace
+{
+  class TreeRemover
+  {
+  public:
+    TreeRemover(size_t numThreads) : numThreads_(numThreads) {}
+    bool remove(const std::string& path);
+  private:
+    struct Dir
+    {
+      size_t parent;        // index in dirs_, npos for the root
+      std::string name;     // in parent, or the root's path
+      std::string path;     // for error messages and, on Windows, calls
+      int fd;               // open while expanded, POSIX only
+    };
+    static const size_t npos = (size_t)-1;
+    static const size_t maxExpanded = 128;  // bounds descriptors held
+
+    bool open(Dir& dir);
+    void expand(size_t index);
+    void removeSubtree(const Dir& dir);
+    void removeEmpty(const Dir& dir);
+    void removeContents(std::string& path, int fd);
+    void fail(const char* call, const std::string& path);
+    static bool isDots(const char* name);
+#ifdef _WIN32
+    void removeFile(const std::string& path, unsigned long attrib);
+#else
+    int parentFd(const Dir& dir) const;
+#endif
+
+    std::vector<Dir> dirs_;
+    size_t numThreads_;
+    std::mutex mtx_;        // guards first_
+    SystemError first_;
+  };
+
+  //----< remove tree at path, returns false if any entry remains >--------
+
+  bool TreeRemover::remove(const std::string& path)
+  {
+    if (numThreads_ == 0)
+      numThreads_ = Utilities::ThreadPool::defaultThreads();
+    dirs_.push_back(Dir{ npos, path, path, -1 });
+    if (!open(dirs_[0]))
+    {
+      lastError_ = first_;
+      return false;
+    }
+    size_t next = 0;        // dirs_ before next have been expanded
+    while (next < dirs_.size() && next < maxExpanded && dirs_.size() - next < 4 * numThreads_)
+    {
+      if (open(dirs_[next]))
+        expand(next);
+      ++next;
+    }
+    Utilities::parallelFor(dirs_.size() - next, [this, next](size_t i) {
+      removeSubtree(dirs_[next + i]);
+    }, numThreads_);
+    for (size_t i = next; i-- > 0; )
+      removeEmpty(dirs_[i]);
+    if (first_.code() == 0)
+      return true;
+    lastError_ = first_;
+    return false;
+  }
+  //----< keep the first failure for the caller's thread >-----------------
+
+  void TreeRemover::fail(const char* call, const std::string& path)
+  {
+    WindowsHelpers::ErrorCode code = WindowsHelpers::lastSystemError();
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (first_.code() == 0)
+      first_.assign(code, call, path);
+  }
+  bool TreeRemover::isDots(const char* name)
+  {
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+  }
+#ifndef _WIN32
+  int TreeRemover::parentFd(const Dir& dir) const
+  {
+    return dir.parent == npos ? AT_FDCWD : dirs_[dir.parent].fd;
+  }
+  //----< open dir for expansion, without following links >----------------
+
+  bool TreeRemover::open(Dir& dir)
+  {
+    if (dir.fd >= 0)
+      return true;
+    dir.fd = ::openat(parentFd(dir), dir.name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (dir.fd < 0)
+      fail("openat", dir.path);
+    return dir.fd >= 0;
+  }
+  //----< remove files of an expanded dir, queue its subdirectories >------
+
+  void TreeRemover::expand(size_t index)
+  {
+    int fd = ::dup(dirs_[index].fd);  // closedir closes its descriptor
+    DIR* pDir = fd < 0 ? nullptr : ::fdopendir(fd);
+    if (pDir == nullptr)
+    {
+      fail("fdopendir", dirs_[index].path);
+      if (fd >= 0)
+        ::close(fd);
+      return;
+    }
+    while (struct dirent* pEntry = ::readdir(pDir))
+    {
+      const char* name = pEntry->d_name;
+      if (isDots(name))
+        continue;
+      std::string path;
+      PathView::join(dirs_[index].path, name, path);
+      bool isDir = false;
+#ifdef _DIRENT_HAVE_D_TYPE
+      if (pEntry->d_type != DT_UNKNOWN)
+        isDir = pEntry->d_type == DT_DIR;
+      else
+#endif
+      {
+        struct stat st;
+        isDir = ::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+      }
+      if (isDir)
+        dirs_.push_back(Dir{ index, name, std::move(path), -1 });
+      else if (::unlinkat(fd, name, 0) != 0)
+        fail("unlinkat", path);
+    }
+    ::closedir(pDir);
+  }
+  //----< remove a queued subtree, run by a worker >-----------------------
+
+  void TreeRemover::removeSubtree(const Dir& dir)
+  {
+    int fd = ::openat(parentFd(dir), dir.name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0)
+    {
+      fail("openat", dir.path);
+      return;
+    }
+    std::string path = dir.path;
+    removeContents(path, fd);
+    if (::unlinkat(parentFd(dir), dir.name.c_str(), AT_REMOVEDIR) != 0)
+      fail("unlinkat", dir.path);
+  }
+  //----< remove an expanded dir, after its contents are gone >------------
+
+  void TreeRemover::removeEmpty(const Dir& dir)
+  {
+    if (dir.fd < 0)
+      return;               // failure already recorded
+    ::close(dir.fd);
+    if (::unlinkat(parentFd(dir), dir.name.c_str(), AT_REMOVEDIR) != 0)
+      fail("unlinkat", dir.path);
+  }
+  //----< depth first removal of everything in fd, which it closes >-------
+  /*
+   * path names fd, and is extended with each entry's name, then cut
+   * back, so error messages cost no allocation per entry.
+   */
+  void TreeRemover::removeContents(std::string& path, int fd)
+  {
+    DIR* pDir = ::fdopendir(fd);
+    if (pDir == nullptr)
+    {
+      fail("fdopendir", path);
+      ::close(fd);
+      return;
+    }
+    size_t len = path.size();
+    while (struct dirent* pEntry = ::readdir(pDir))
+    {
+      const char* name = pEntry->d_name;
+      if (isDots(name))
+        continue;
+      bool isDir = false;
+#ifdef _DIRENT_HAVE_D_TYPE
+      if (pEntry->d_type != DT_UNKNOWN)
+        isDir = pEntry->d_type == DT_DIR;
+      else
+#endif
+      {
+        struct stat st;
+        isDir = ::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode);
+      }
+      path += PathResolver::separator;
+      path += name;
+      if (!isDir)
+      {
+        if (::unlinkat(fd, name, 0) != 0)
+          fail("unlinkat", path);
+      }
+      else
+      {
+        int child = ::openat(fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        if (child < 0)
+          fail("openat", path);
+        else
+        {
+          removeContents(path, child);
+          if (::unlinkat(fd, name, AT_REMOVEDIR) != 0)
+            fail("unlinkat", path);
+        }
+      }
+      path.resize(len);
+    }
+    ::closedir(pDir);
+  }
+#else
+  //----< nothing to open, Windows removes by path >-----------------------
+
+  bool TreeRemover::open(Dir& dir)
+  {
+    if (dir.parent != npos)
+      return true;
+    DWORD attrib = ::GetFileAttributesA(dir.path.c_str());
+    if (attrib != INVALID_FILE_ATTRIBUTES && (attrib & FILE_ATTRIBUTE_DIRECTORY) != 0)
+      return true;
+    if (attrib != INVALID_FILE_ATTRIBUTES)
+      ::SetLastError(ERROR_DIRECTORY);
+    fail("GetFileAttributesA", dir.path);
+    return false;
+  }
+  //----< remove a file, clearing read-only, which blocks DeleteFileA >----
+
+  void TreeRemover::removeFile(const std::string& path, unsigned long attrib)
+  {
+    if (attrib & FILE_ATTRIBUTE_READONLY)
+      ::SetFileAttributesA(path.c_str(), attrib & ~FILE_ATTRIBUTE_READONLY);
+    if (::DeleteFileA(path.c_str()) == 0)
+      fail("DeleteFileA", path);
+  }
+  //----< remove files of an expanded dir, queue its subdirectories >------
+
+  void TreeRemover::expand(size_t index)
+  {
+    WIN32_FIND_DATAA data;
+    std::string pattern;
+    PathView::join(dirs_[index].path, "*", pattern);
+    HANDLE hFind = ::FindFirstFileA(pattern.c_str(), &data);
+    if (hFind == INVALID_HANDLE_VALUE)
+    {
+      fail("FindFirstFileA", dirs_[index].path);
+      return;
+    }
+    do
+    {
+      if (isDots(data.cFileName))
+        continue;
+      std::string path;
+      PathView::join(dirs_[index].path, data.cFileName, path);
+      if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+        removeFile(path, data.dwFileAttributes);
+      else if ((data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0)
+        dirs_.push_back(Dir{ index, data.cFileName, std::move(path), -1 });
+      else if (::RemoveDirectoryA(path.c_str()) == 0)  // junction, not its target
+        fail("RemoveDirectoryA", path);
+    } while (::FindNextFileA(hFind, &data));
+    ::FindClose(hFind);
+  }
+  //----< remove a queued subtree, run by a worker >-----------------------
+
+  void TreeRemover::removeSubtree(const Dir& dir)
+  {
+    std::string path = dir.path;
+    removeContents(path, -1);
+    if (::RemoveDirectoryA(dir.path.c_str()) == 0)
+      fail("RemoveDirectoryA", dir.path);
+  }
+  //----< remove an expanded dir, after its contents are gone >------------
+
+  void TreeRemover::removeEmpty(const Dir& dir)
+  {
+    if (::RemoveDirectoryA(dir.path.c_str()) == 0)
+      fail("RemoveDirectoryA", dir.path);
+  }
+  //----< depth first removal of everything in path >----------------------
+
+  void TreeRemover::removeContents(std::string& path, int)
+  {
+    WIN32_FIND_DATAA data;
+    size_t len = path.size();
+    path += "\\*";
+    HANDLE hFind = ::FindFirstFileA(path.c_str(), &data);
+    path.resize(len);
+    if (hFind == INVALID_HANDLE_VALUE)
+    {
+      fail("FindFirstFileA", path);
+      return;
+    }
+    do
+    {
+      if (isDots(data.cFileName))
+        continue;
+      path += '\\';
+      path += data.cFileName;
+      if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+        removeFile(path, data.dwFileAttributes);
+      else
+      {
+        if ((data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0)
+          removeContents(path, -1);
+        if (::RemoveDirectoryA(path.c_str()) == 0)
+          fail("RemoveDirectoryA", path);
+      }
+      path.resize(len);
+    } while (::FindNextFileA(hFind, &data));
+    ::FindClose(hFind);
+  }
+#endif
+}
+//----< remove directory at path and everything below it >-----------------
+/*
+ * Keeps going past failures, so as much as possible is removed, then
+ * returns false, with lastError() holding the first failure, if any
+ * entry remains.
+ */
+bool Directory::removeTree(const std::string& path, size_t numThreads)
+{
+  TreeRemover remover(numThreads);
+  return remover.remove(path);
+}
+#ifdef _WIN32
 //----< find first file >--------------------------------------------------
 
 std::string FileSystemSearch::firstFile(const std::string& path, const std::string& pattern)
 {
   hFindFile = ::FindFirstFileA(Path::fileSpec(path, pattern).c_str(), pFindFileData);
-  if(hFindFile != INVALID_HANDLE_VALUE)
+  if(hFindFile == INVALID_HANDLE_VALUE)
+    recordFindError(path);
+  else
   {
     if(!(pFindFileData->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
       return pFindFileData->cFileName;
@@ -742,7 +1591,9 @@ std::string FileSystemSearch::nextFile()
 std::string FileSystemSearch::firstDirectory(const std::string& path, const std::string& pattern)
 {
   hFindFile = ::FindFirstFileA(Path::fileSpec(path, pattern).c_str(), pFindFileData);
-  if(hFindFile != INVALID_HANDLE_VALUE)
+  if(hFindFile == INVALID_HANDLE_VALUE)
+    recordFindError(path);
+  else
   {
     if(pFindFileData->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
       return pFindFileData->cFileName;
@@ -762,6 +1613,125 @@ std::string FileSystemSearch::nextDirectory()
       return pFindFileData->cFileName;
   return "";
 }
+//----< append matching names directly from find data >--------------------
+/*
+ * Copies cFileName into the arena, so no std::string is built per name.
+ */
+size_t FileSystemSearch::appendNames(
+  const std::string& path, const std::string& pattern, NameArena& names, bool wantDirs
+)
+{
+  size_t count = 0;
+  hFindFile = ::FindFirstFileA(Path::fileSpec(path, pattern).c_str(), pFindFileData);
+  if(hFindFile == INVALID_HANDLE_VALUE)
+  {
+    recordFindError(path);
+    return count;
+  }
+  do
+  {
+    bool isDir = (pFindFileData->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+    if(isDir == wantDirs)
+    {
+      names.add(pFindFileData->cFileName, strlen(pFindFileData->cFileName));
+      ++count;
+    }
+  } while(::FindNextFileA(hFindFile, pFindFileData));
+  return count;
+}
+#else
+//----< open path for names matching pattern >-----------------------------
+/*
+ * "*.*" matches every name, as it does for FindFirstFileA, although
+ * fnmatch would require a dot.
+ */
+bool FileSystemSearch::open(const std::string& path, const std::string& pattern)
+{
+  close();
+  path_ = path;
+  pattern_ = (pattern == "*.*") ? "*" : pattern;
+  pDir = ::opendir(path.c_str());
+  if (pDir == nullptr && errno != ENOENT)
+    recordError("opendir", path);
+  return pDir != nullptr;
+}
+//----< next matching name that is, or isn't, a directory >----------------
+/*
+ * A symbolic link is reported as a file, even if it names a directory,
+ * so recursive walks don't follow links into cycles.
+ */
+const char* FileSystemSearch::next(bool wantDirs)
+{
+  if (pDir == nullptr)
+    return nullptr;
+  while (struct dirent* pEntry = ::readdir(pDir))
+  {
+    const char* name = pEntry->d_name;
+    if (pattern_ != "*" && ::fnmatch(pattern_.c_str(), name, 0) != 0)
+      continue;
+    bool isDir = false;
+#ifdef _DIRENT_HAVE_D_TYPE
+    if (pEntry->d_type != DT_UNKNOWN)
+      isDir = pEntry->d_type == DT_DIR;
+    else
+#endif
+    {
+      struct stat st;
+      PathView::join(path_, name, entry_);
+      isDir = ::lstat(entry_.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+    }
+    if (isDir == wantDirs)
+      return name;
+  }
+  return nullptr;
+}
+//----< find first file >--------------------------------------------------
+
+std::string FileSystemSearch::firstFile(const std::string& path, const std::string& pattern)
+{
+  if (!open(path, pattern))
+    return "";
+  return nextFile();
+}
+//----< find next file >---------------------------------------------------
+
+std::string FileSystemSearch::nextFile()
+{
+  const char* name = next(false);
+  return name != nullptr ? name : "";
+}
+//----< find first directory >---------------------------------------------
+
+std::string FileSystemSearch::firstDirectory(const std::string& path, const std::string& pattern)
+{
+  if (!open(path, pattern))
+    return "";
+  return nextDirectory();
+}
+//----< find next directory >----------------------------------------------
+
+std::string FileSystemSearch::nextDirectory()
+{
+  const char* name = next(true);
+  return name != nullptr ? name : "";
+}
+//----< append matching names directly from directory entries >------------
+
+size_t FileSystemSearch::appendNames(
+  const std::string& path, const std::string& pattern, NameArena& names, bool wantDirs
+)
+{
+  size_t count = 0;
+  if (!open(path, pattern))
+    return count;
+  while (const char* name = next(wantDirs))
+  {
+    names.add(name, strlen(name));
+    ++count;
+  }
+  return count;
+}
+#endif
 //----< test stub >--------------------------------------------------------
 
 #ifdef TEST_FILESYSTEM
@@ -839,6 +1809,13 @@ int main(int argc, char* argv[])
   for (size_t i = 0; i<currfiles.size(); ++i)
     std::cout << "\n    " << Path::fileSpec("c:\\temp\\", currfiles[i]).c_str();
 
+  std::cout << "\n";
+  std::cout << "\n  .txt files residing in C:/temp, collected in a NameArena:";
+  NameArena names;
+  Directory::getFiles("c:/temp/", "*.txt", names);
+  for (size_t i = 0; i < names.size(); ++i)
+    std::cout << "\n    " << names.c_str(i);
+
   std::cout << "\n";
   std::cout << "\n  directories residing in C:/temp are:";
   currdirs = Directory::getDirectories("c:/temp/");
@@ -846,6 +1823,21 @@ int main(int argc, char* argv[])
     std::cout << "\n    " << currdirs[i].c_str();
   std::cout << "\n";
 
+  // Create and remove directory trees
+
+  title("Demonstrate Directory::createTree and removeTree");
+  std::string tree = Path::fileSpec("FileSystemTreeTest", "a/b/c");
+  std::cout << "\n  createTree(\"" << tree << "\") " << (Directory::createTree(tree) ? "succeeded" : lastError().what());
+  std::cout << "\n  again " << (Directory::createTree(tree) ? "succeeded, it exists" : lastError().what());
+  for (size_t i = 0; i < 10; ++i)
+  {
+    File f(Path::fileSpec(tree, "file" + std::to_string(i) + ".txt"));
+    f.open(File::out);
+  }
+  std::cout << "\n  removeTree(\"FileSystemTreeTest\") " << (Directory::removeTree("FileSystemTreeTest") ? "succeeded" : lastError().what());
+  std::cout << "\n  it " << (Directory::exists("FileSystemTreeTest") ? "still exists - error" : "no longer exists");
+  std::cout << "\n";
+
   // Create directory
 
   title("Demonstrate FileInfo Class Operations", '=');
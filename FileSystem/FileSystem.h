@@ -2,7 +2,7 @@
 #define FILESYSTEM_H
 /////////////////////////////////////////////////////////////////////////////
 // FileSystem.h - Support file and directory operations                    //
-// ver 2.9                                                                 //
+// ver 3.7                                                                 //
 // ----------------------------------------------------------------------- //
 // copyright  Jim Fawcett, 2012                                           //
 // All rights granted provided that this notice is retained                //
@@ -58,28 +58,84 @@
  *  -- If you have a filespec relative to some other path
  *  -- you need to setCurrentPath(newPath), use getFullFileSpec(...)
  *  -- then reset the current path with setCurrentPath(origPath)
+ *  -- Walkers resolving many paths should use PathResolver, in
+ *  -- PathResolver.h, which caches the current directory
  * std::string fullyqualified = Path::fileSpec(path, filename);
  *  -- This simply concatenates path with filename
+ * PathView view(fullyqualified);            // no allocation
+ * if (view.ext().equalsNoCase("cpp")) ...  // also dir(), name(), stem()
  * std::string path = Path::getPath(fullyqualified);
  * std::string name = Path::getName(fullyqualified);
  * std::string extn = Path::getExt(fullyqualified);
+ *  -- lower case; see CaseFold.h for in place conversions and
+ *  -- case-insensitive hash and equality functors
  *
  * Directory d;
  * std::string dir = d.getCurrentDirectory();
  * d.setCurrentDirectory(dir);
  * std::vector<std::string> files = Directory::getFiles(path, pattern);
  * std::vector<std::string> dirs = Directory::getDirectories(path);
+ *
+ * NameArena names;                          // reuse for each directory
+ * Directory::getFiles(path, pattern, names);  // appends, returns count
+ * for (size_t i = 0; i < names.size(); ++i)
+ *   std::cout << names.c_str(i);
+ * names.reset();
+ *
+ * File::copy(src, dst);                 // reflink or in-kernel copy on Linux
+ *
+ * if (!Directory::create(path))
+ *   throw FileSystem::lastError();     // SystemError: call, path, and message
+ * Directory::createTree("out/obj/x64");  // like mkdir -p
+ * Directory::removeTree("out");          // like rm -r, in parallel
  * 
  * Required Files:
  * ===============
  * FileSystem.h, FileSystem.cpp
+ * NameArena.h, CaseFold.h, PathView.h, PathResolver.h, ErrorMessages.h
+ * ThreadPool.h                         // Directory::removeTree
  *
  * Build Command:
  * ==============
  * cl /EHa /DTEST_FILESYSTEM FileSystem.cpp
+ * g++ -std=c++14 -DTEST_FILESYSTEM FileSystem.cpp
  *
  * Maintenance History:
  * ====================
+ * ver 3.7 : 19 Oct 2026
+ * - added setLastError, so DirectFile, and other packages built on
+ *   FileSystem, report failures through lastError()
+ * ver 3.6 : 19 Oct 2026
+ * - added Directory::createTree, which creates missing ancestors too,
+ *   backing up from path only as far as the deepest one that exists
+ * - added Directory::removeTree, which removes subtrees in parallel,
+ *   naming entries relative to open directory descriptors on POSIX
+ * ver 3.5 : 19 Oct 2026
+ * - builds on Linux and other POSIX systems: searches use readdir
+ *   and fnmatch, FileInfo uses stat, directories use mkdir, rmdir,
+ *   and chdir, and getFullFileSpec uses PathResolver
+ * - on Linux File::copy clones with FICLONE where the file system
+ *   shares extents, else copies in the kernel with copy_file_range
+ *   or sendfile, falling back to a large buffer, and skips holes so
+ *   sparse files stay sparse.  Mode and times are preserved.
+ * ver 3.4 : 19 Oct 2026
+ * - Path::getName, getExt, getPath, and fileSpec parse with PathView,
+ *   which treats '/' and '\' alike, so mixed separators work
+ * - getName(spec, false) now drops only the last extension, agreeing
+ *   with getExt, and no longer drops an extra char when spec has no path
+ * ver 3.3 : 19 Oct 2026
+ * - Path::toLower, toUpper, and getExt convert case with CaseFold.h,
+ *   a block at a time for ASCII, rather than appending a char at a time
+ * ver 3.2 : 19 Oct 2026
+ * - Path::getFullFileSpec sizes its buffer to the path, so long paths
+ *   are no longer truncated at 256 chars
+ * ver 3.1 : 19 Oct 2026
+ * - failing operations record the error code, the call, and the path
+ *   for lastError(), a per thread SystemError that callers may throw
+ * - Directory::create and Directory::remove now return true on success
+ * ver 3.0 : 19 Oct 2026
+ * - added Directory::getFiles and getDirectories overloads that append
+ *   names to a caller owned NameArena, avoiding a string per name
  * ver 2.9 : 06 Sep 2018
  * - Fixed bug in File::isGood() by returning result of comparison, not assignment
  * ver 2.8 : 23 Feb 2018
@@ -124,10 +180,27 @@
 #include <fstream>
 #include <string>
 #include <vector>
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+#include "NameArena.h"
+#include "CaseFold.h"
+#include "PathView.h"
+#include "../WindowsHelpers/ErrorMessages.h"
 
 namespace FileSystem
 {
+  /////////////////////////////////////////////////////////
+  // lastError
+  // - the calling thread's most recent failure, like errno,
+  //   only meaningful after a call reports failure
+
+  using WindowsHelpers::SystemError;
+  const SystemError& lastError();
+  void setLastError(const SystemError& error);  // for packages built on FileSystem
+
   /////////////////////////////////////////////////////////
   // Block
   
@@ -221,8 +294,13 @@ namespace FileSystem
   private:
     bool good_;
     static std::string intToString(long i);
+#ifdef _WIN32
     WIN32_FIND_DATAA data;
     HANDLE hFindFile;
+#else
+    std::string name_;
+    struct stat data;
+#endif
   };
 
   /////////////////////////////////////////////////////////
@@ -247,12 +325,16 @@ namespace FileSystem
   {
   public:
     static bool create(const std::string& path);
+    static bool createTree(const std::string& path);
     static bool remove(const std::string& path);
+    static bool removeTree(const std::string& path, size_t numThreads = 0);
     static bool exists(const std::string& path);
     static std::string getCurrentDirectory();
     static bool setCurrentDirectory(const std::string& path);
     static std::vector<std::string> getFiles(const std::string& path=".", const std::string& pattern="*.*");
     static std::vector<std::string> getDirectories(const std::string& path=".", const std::string& pattern="*.*");
+    static size_t getFiles(const std::string& path, const std::string& pattern, NameArena& names);
+    static size_t getDirectories(const std::string& path, const std::string& pattern, NameArena& names);
   };
 }
 
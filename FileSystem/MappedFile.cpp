@@ -0,0 +1,170 @@
+/////////////////////////////////////////////////////////////////////
+// MappedFile.cpp - read-only memory mapped view of a file         //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace FileSystem;
+
+#ifdef _WIN32
+
+//----< map file contents, read-only >-------------------------------
+
+MappedFile::MappedFile(const std::string& fileSpec) : name_(fileSpec)
+{
+  HANDLE hFile = ::CreateFileA(
+    fileSpec.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL
+  );
+  if (hFile == INVALID_HANDLE_VALUE)
+    return;
+  hFile_ = hFile;
+
+  LARGE_INTEGER fileSize;
+  if (!::GetFileSizeEx(hFile, &fileSize) || (unsigned long long)fileSize.QuadPart > (size_t)-1)
+  {
+    close();
+    return;
+  }
+  size_ = (size_t)fileSize.QuadPart;
+  if (size_ == 0)
+  {
+    good_ = true;  // can't map empty file, but it's not an error
+    return;
+  }
+  hMap_ = ::CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (hMap_ == NULL)
+  {
+    close();
+    return;
+  }
+  pData_ = static_cast<const char*>(::MapViewOfFile(hMap_, FILE_MAP_READ, 0, 0, 0));
+  if (pData_ == nullptr)
+  {
+    close();
+    return;
+  }
+  good_ = true;
+}
+//----< release view and handles >-----------------------------------
+
+void MappedFile::close()
+{
+  if (pData_ != nullptr)
+    ::UnmapViewOfFile(pData_);
+  if (hMap_ != nullptr)
+    ::CloseHandle(hMap_);
+  if (hFile_ != nullptr)
+    ::CloseHandle(hFile_);
+  pData_ = nullptr;
+  hMap_ = nullptr;
+  hFile_ = nullptr;
+  size_ = 0;
+  good_ = false;
+}
+
+#else
+
+//----< map file contents, read-only >-------------------------------
+
+MappedFile::MappedFile(const std::string& fileSpec) : name_(fileSpec)
+{
+  fd_ = ::open(fileSpec.c_str(), O_RDONLY);
+  if (fd_ < 0)
+    return;
+
+  struct stat st;
+  if (::fstat(fd_, &st) != 0 || !S_ISREG(st.st_mode))
+  {
+    close();
+    return;
+  }
+  size_ = (size_t)st.st_size;
+  if (size_ == 0)
+  {
+    good_ = true;  // can't map empty file, but it's not an error
+    return;
+  }
+  void* pMap = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (pMap == MAP_FAILED)
+  {
+    close();
+    return;
+  }
+  ::madvise(pMap, size_, MADV_SEQUENTIAL);
+  pData_ = static_cast<const char*>(pMap);
+  good_ = true;
+}
+//----< release mapping and descriptor >-----------------------------
+
+void MappedFile::close()
+{
+  if (pData_ != nullptr)
+    ::munmap(const_cast<char*>(pData_), size_);
+  if (fd_ >= 0)
+    ::close(fd_);
+  pData_ = nullptr;
+  fd_ = -1;
+  size_ = 0;
+  good_ = false;
+}
+
+#endif
+
+//----< destructor unmaps file >-------------------------------------
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+//----< test stub >--------------------------------------------------
+
+#ifdef TEST_MAPPEDFILE
+
+#include <iostream>
+#include <algorithm>
+
+int main(int argc, char* argv[])
+{
+  std::cout << "\n  Demonstrate MappedFile";
+  std::cout << "\n ========================";
+
+  std::string fileSpec = argc > 1 ? argv[1] : "MappedFile.h";
+  MappedFile mf(fileSpec);
+  if (!mf.good())
+  {
+    std::cout << "\n  can't map \"" << fileSpec << "\"\n\n";
+    return 1;
+  }
+  std::cout << "\n  mapped \"" << mf.name() << "\", " << mf.size() << " bytes";
+
+  size_t lines = 0;
+  for (size_t i = 0; i < mf.size(); ++i)
+    if (mf.data()[i] == '\n')
+      ++lines;
+  std::cout << "\n  file has " << lines << " lines";
+  const char* pEol = std::find(mf.data(), mf.data() + mf.size(), '\n');
+  std::cout << "\n  first line: " << std::string(mf.data(), pEol);
+
+  MappedFile missing("foobar");
+  std::cout << "\n  mapping \"foobar\" " << (missing.good() ? "succeeded - error" : "failed as expected");
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
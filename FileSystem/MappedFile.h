@@ -0,0 +1,82 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// MappedFile.h - read-only memory mapped view of a file           //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides a MappedFile class that maps the entire
+* contents of a file into the address space of the process, read-only.
+* That lets applications scan a file's bytes without copying them
+* through stream buffers.  Pages are loaded on demand by the OS.
+*
+* Uses CreateFileMapping/MapViewOfFile on Windows and mmap elsewhere.
+*
+* Public Interface:
+* -----------------
+*   MappedFile mf("../foobar.dat");
+*   if (mf.good())
+*     process(mf.data(), mf.size());
+*
+* Required Files:
+* ---------------
+*   MappedFile.h, MappedFile.cpp
+*
+* Build Command:
+* --------------
+*   cl /EHa /DTEST_MAPPEDFILE MappedFile.cpp
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*
+* Notes:
+* ------
+* - An empty file is good() with size() == 0 and data() == nullptr.
+* - A file too large for the address space, e.g., > 2GB in a 32 bit
+*   process, will fail to map, so good() returns false.  Callers
+*   should fall back to stream reads.
+*/
+
+#include <string>
+
+namespace FileSystem
+{
+  class MappedFile
+  {
+  public:
+    MappedFile(const std::string& fileSpec);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    bool good() const;
+    const char* data() const;
+    size_t size() const;
+    std::string name() const;
+    void close();
+  private:
+    std::string name_;
+    const char* pData_ = nullptr;
+    size_t size_ = 0;
+    bool good_ = false;
+#ifdef _WIN32
+    void* hFile_ = nullptr;
+    void* hMap_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+  };
+
+  inline bool MappedFile::good() const { return good_; }
+  inline const char* MappedFile::data() const { return pData_; }
+  inline size_t MappedFile::size() const { return size_; }
+  inline std::string MappedFile::name() const { return name_; }
+}
@@ -0,0 +1,50 @@
+/////////////////////////////////////////////////////////////////////
+// NameArena.cpp - test stub for NameArena                         //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+*  NameArena.h is header only.  This file holds its test stub.
+*/
+
+#ifdef TEST_NAMEARENA
+
+#include "NameArena.h"
+#include <iostream>
+#include <algorithm>
+
+using namespace FileSystem;
+
+int main()
+{
+  std::cout << "\n  Testing NameArena";
+  std::cout << "\n ===================";
+
+  NameArena names;
+  names.reserve(4, 32);
+  names.add("zeta.h");
+  names.add("alpha.cpp");
+  names.add(std::string("mid.txt"));
+  names.add("alpha.cpp");
+
+  std::cout << "\n  " << names.size() << " names in " << names.chars() << " chars";
+
+  std::vector<size_t> index(names.size());
+  for (size_t i = 0; i < index.size(); ++i)
+    index[i] = i;
+  std::sort(index.begin(), index.end(), [&names](size_t i, size_t j) {
+    return names.compare(i, j) < 0;
+  });
+  for (auto i : index)
+    std::cout << "\n    " << names.c_str(i) << " (" << names.length(i) << ")";
+
+  names.reset();
+  std::cout << "\n  after reset: " << names.size() << " names";
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,135 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// NameArena.h - compact contiguous storage for many short strings //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* NameArena stores names, e.g., file and directory names, end to end
+* in one char buffer, with a table of (offset, length) entries that
+* locate each name.  Adding a name costs no heap allocation once the
+* buffer and table have grown to their working sizes, and reset()
+* discards the names but keeps that capacity for reuse.
+*
+* Each name is followed by '\0', so c_str(i) can be handed to C APIs.
+* Offsets are 32 bits, so an arena holds at most 4GB of characters.
+*
+* Public Interface:
+* -----------------
+*   NameArena names;
+*   names.add("foobar.txt");
+*   for (size_t i = 0; i < names.size(); ++i)
+*     std::cout << names.c_str(i) << " has " << names.length(i) << " chars";
+*   names.reset();     // reuse for next directory
+*
+* Required Files:
+* ---------------
+*   NameArena.h, NameArena.cpp  // NameArena.cpp just for testing
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+namespace FileSystem
+{
+  class NameArena
+  {
+  public:
+    using Index = size_t;
+
+    Index add(const char* name, size_t len);
+    Index add(const std::string& name);
+    void reset();
+    void reserve(size_t numNames, size_t numChars);
+
+    size_t size() const;
+    bool empty() const;
+    size_t chars() const;
+    const char* c_str(Index i) const;
+    size_t length(Index i) const;
+    std::string str(Index i) const;
+    int compare(Index i, Index j) const;
+  private:
+    struct Entry
+    {
+      uint32_t offset;
+      uint32_t length;
+    };
+    std::vector<char> chars_;
+    std::vector<Entry> entries_;
+  };
+
+  //----< append name, returning its index >-------------------------
+
+  inline NameArena::Index NameArena::add(const char* name, size_t len)
+  {
+    if (chars_.size() + len + 1 > UINT32_MAX)
+      throw std::length_error("NameArena capacity exceeded");
+    Entry entry{ (uint32_t)chars_.size(), (uint32_t)len };
+    chars_.insert(chars_.end(), name, name + len);
+    chars_.push_back('\0');
+    entries_.push_back(entry);
+    return entries_.size() - 1;
+  }
+
+  inline NameArena::Index NameArena::add(const std::string& name)
+  {
+    return add(name.data(), name.size());
+  }
+  //----< discard names, keeping capacity >--------------------------
+
+  inline void NameArena::reset()
+  {
+    chars_.clear();
+    entries_.clear();
+  }
+
+  inline void NameArena::reserve(size_t numNames, size_t numChars)
+  {
+    entries_.reserve(numNames);
+    chars_.reserve(numChars + numNames);
+  }
+
+  inline size_t NameArena::size() const { return entries_.size(); }
+  inline bool NameArena::empty() const { return entries_.empty(); }
+  inline size_t NameArena::chars() const { return chars_.size(); }
+
+  inline const char* NameArena::c_str(Index i) const
+  {
+    return chars_.data() + entries_[i].offset;
+  }
+
+  inline size_t NameArena::length(Index i) const
+  {
+    return entries_[i].length;
+  }
+
+  inline std::string NameArena::str(Index i) const
+  {
+    return std::string(c_str(i), length(i));
+  }
+  //----< lexicographic comparison of names i and j >----------------
+
+  inline int NameArena::compare(Index i, Index j) const
+  {
+    size_t len1 = length(i), len2 = length(j);
+    int cmp = std::memcmp(c_str(i), c_str(j), len1 < len2 ? len1 : len2);
+    if (cmp != 0)
+      return cmp;
+    return len1 < len2 ? -1 : (len1 > len2 ? 1 : 0);
+  }
+}
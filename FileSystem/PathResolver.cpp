@@ -0,0 +1,90 @@
+/////////////////////////////////////////////////////////////////////
+// PathResolver.cpp - test stub for PathResolver                   //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+*  PathResolver.h is header only.  This file holds its test stub.
+*/
+
+#ifdef TEST_PATHRESOLVER
+
+#include "PathResolver.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+
+using namespace FileSystem;
+
+void show(const std::string& label, const std::string& path)
+{
+  std::cout << "\n  " << label << "\n    " << path;
+}
+
+int main()
+{
+  std::cout << "\n  Testing PathResolver";
+  std::cout << "\n ======================";
+
+  PathResolver resolver;
+  show("current directory:", resolver.currentDirectory());
+  show("resolve(\".\"):", resolver.resolve("."));
+  show("resolve(\"../FileSystem/./sub//..\"):", resolver.resolve("../FileSystem/./sub//.."));
+#ifdef _WIN32
+  show("resolve(\"C:\\\\a\\\\..\\\\..\\\\b\"):", resolver.resolve("C:\\a\\..\\..\\b"));
+  show("resolve(\"\\\\\\\\server\\\\share\\\\a\\\\..\\\\..\"):", resolver.resolve("\\\\server\\share\\a\\..\\.."));
+#else
+  show("resolve(\"/a/../../b\"):", resolver.resolve("/a/../../b"));
+#endif
+
+  std::string dir = resolver.resolve(".");
+  show("resolve(dir, \"PathResolver.h\"):", resolver.resolve(dir, "PathResolver.h"));
+  show("resolve(dir, \"..\"):", resolver.resolve(dir, ".."));
+
+  std::string deep = "deep";
+  for (size_t i = 0; i < 100; ++i)
+    deep += std::string(1, PathResolver::separator) + "level" + std::to_string(i);
+  std::cout << "\n  resolving a " << deep.size() << " char path gives "
+    << resolver.resolve(deep).size() << " chars, no truncation";
+
+  const size_t count = 1000000;
+  auto start = std::chrono::steady_clock::now();
+  size_t chars = 0;
+  for (size_t i = 0; i < count; ++i)
+    chars += resolver.resolve(dir, "child").size();
+  std::chrono::duration<double> secs = std::chrono::steady_clock::now() - start;
+  std::cout << "\n  " << count << " child resolutions in " << secs.count() << " sec";
+
+#ifndef _WIN32
+  std::cout << "\n\n  resolving links";
+  std::cout << "\n -----------------";
+  std::string linkDir = dir + "/resolverTest";
+  ::mkdir(linkDir.c_str(), 0755);
+  ::mkdir((linkDir + "/real").c_str(), 0755);
+  std::ofstream((linkDir + "/real/file.txt").c_str()) << "data";
+  ::symlink("real", (linkDir + "/rel").c_str());
+  ::symlink((linkDir + "/real").c_str(), (linkDir + "/abs").c_str());
+  ::symlink("rel/../real/file.txt", (linkDir + "/chain").c_str());
+  ::symlink("loop", (linkDir + "/loop").c_str());
+
+  PathResolver real(true);
+  show("rel/file.txt:", real.resolve(linkDir + "/rel/file.txt"));
+  show("abs/file.txt:", real.resolve(linkDir + "/abs/file.txt"));
+  show("chain:", real.resolve(linkDir + "/chain"));
+  show("loop:", real.resolve(linkDir + "/loop"));
+  show("rel/.. (links first, then \"..\", as realpath):", real.resolve(linkDir + "/rel/.."));
+  std::cout << "\n  " << real.memoSize() << " paths memoized";
+
+  for (auto name : { "/rel", "/abs", "/chain", "/loop", "/real/file.txt" })
+    ::unlink((linkDir + name).c_str());
+  ::rmdir((linkDir + "/real").c_str());
+  ::rmdir(linkDir.c_str());
+#endif
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,399 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PathResolver.h - absolute paths without a syscall per directory //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* PathResolver turns relative paths into absolute paths, removing
+* ".", "..", and repeated separators, on Windows and POSIX platforms.
+* Paths have no length limit.
+*
+* Resolution is lexical and uses a cached current directory, so the
+* only system call is the first getcwd or GetCurrentDirectory.  A
+* directory walker that has resolved a directory calls
+* resolve(dir, name) for each child, which appends just the child's
+* name to the resolved parent.
+*
+* With resolveLinks(true), each component is checked for a symbolic
+* link, as realpath does, and links are replaced by their targets.
+* Each checked prefix is memoized, so it costs one lstat, and a
+* readlink if it is a link, however many paths pass through it.
+* On Windows, reparse points are resolved by GetFinalPathNameByHandle.
+*
+* The cached directory and the memos are not refreshed on their own.
+* Call clear() after changing the current directory, or after links
+* change.  A PathResolver is not thread safe; use one per thread.
+*
+* Public Interface:
+* -----------------
+*   PathResolver resolver;
+*   std::string dir = resolver.resolve("../src");    // cwd + "/../src"
+*   std::string file = resolver.resolve(dir, "main.cpp");
+*   resolver.resolveLinks(true);                     // like realpath
+*   std::string real = resolver.resolve("/usr/lib/libc.so");
+*   resolver.clear();                                // after chdir
+*
+* Required Files:
+* ---------------
+*   PathResolver.h, PathResolver.cpp  // PathResolver.cpp just for testing
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cctype>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+namespace FileSystem
+{
+  class PathResolver
+  {
+  public:
+#ifdef _WIN32
+    static const char separator = '\\';
+#else
+    static const char separator = '/';
+#endif
+    static const size_t maxLinks = 40;  // followed per resolve, as ELOOP
+
+    PathResolver(bool resolveLinks = false) : resolveLinks_(resolveLinks) {}
+
+    std::string resolve(const std::string& path);
+    std::string resolve(const std::string& dir, const std::string& name);
+    void resolveLinks(bool resolve);
+    bool resolveLinks() const;
+    const std::string& currentDirectory();
+    void clear();
+    size_t memoSize() const;
+
+    static bool isSeparator(char ch);
+    static size_t rootLength(const std::string& path);
+  private:
+    void walk(std::string& out, const std::string& path, size_t pos, size_t& links);
+    void append(std::string& out, const char* name, size_t len, size_t& links);
+    void followLink(std::string& out, size_t& links);
+    bool readLink(const std::string& path, std::string& target);
+    static std::string root(const std::string& path, size_t rootLen);
+#ifdef _WIN32
+    static std::string fullPathName(const std::string& path);
+#endif
+
+    std::string cwd_;
+    bool resolveLinks_;
+    std::unordered_map<std::string, std::string> memo_;  // path -> path with links resolved
+  };
+
+  //----< is ch a path separator on this platform? >-----------------
+
+  inline bool PathResolver::isSeparator(char ch)
+  {
+#ifdef _WIN32
+    return ch == '\\' || ch == '/';
+#else
+    return ch == '/';
+#endif
+  }
+  //----< length of path's root, zero if path is relative >----------
+  /*
+  *  Windows roots are "X:\" and "\\server\share"; POSIX has just "/".
+  */
+  inline size_t PathResolver::rootLength(const std::string& path)
+  {
+#ifdef _WIN32
+    if (path.size() >= 3 && std::isalpha((unsigned char)path[0]) && path[1] == ':' && isSeparator(path[2]))
+      return 3;
+    if (path.size() >= 2 && isSeparator(path[0]) && isSeparator(path[1]))
+    {
+      size_t pos = 2, seps = 0;
+      for (; pos < path.size(); ++pos)
+      {
+        if (isSeparator(path[pos]) && ++seps == 2)
+          break;
+      }
+      return pos;
+    }
+    return 0;
+#else
+    return !path.empty() && path[0] == '/' ? 1 : 0;
+#endif
+  }
+  //----< copy of path's root with preferred separators >------------
+
+  inline std::string PathResolver::root(const std::string& path, size_t rootLen)
+  {
+    std::string out = path.substr(0, rootLen);
+    for (auto& ch : out)
+    {
+      if (isSeparator(ch))
+        ch = separator;
+    }
+    return out;
+  }
+  //----< turn on or off symbolic link resolution >------------------
+
+  inline void PathResolver::resolveLinks(bool resolve)
+  {
+    resolveLinks_ = resolve;
+  }
+  //----< are symbolic links resolved? >-----------------------------
+
+  inline bool PathResolver::resolveLinks() const
+  {
+    return resolveLinks_;
+  }
+  //----< drop cached current directory and link memos >-------------
+
+  inline void PathResolver::clear()
+  {
+    cwd_.clear();
+    memo_.clear();
+  }
+  //----< number of memoized paths >---------------------------------
+
+  inline size_t PathResolver::memoSize() const
+  {
+    return memo_.size();
+  }
+  //----< current directory, fetched once and then cached >----------
+
+  inline const std::string& PathResolver::currentDirectory()
+  {
+    if (!cwd_.empty())
+      return cwd_;
+#ifdef _WIN32
+    DWORD size = ::GetCurrentDirectoryA(0, NULL);
+    std::vector<char> buffer(size + 1);
+    DWORD len = ::GetCurrentDirectoryA((DWORD)buffer.size(), buffer.data());
+    cwd_.assign(buffer.data(), len < buffer.size() ? len : 0);
+#else
+    std::vector<char> buffer(256);
+    while (::getcwd(buffer.data(), buffer.size()) == nullptr && errno == ERANGE)
+      buffer.resize(2 * buffer.size());
+    cwd_ = buffer.data();
+#endif
+    if (cwd_.empty())
+      cwd_ = std::string(1, separator);  // cwd removed; best we can do
+    return cwd_;
+  }
+#ifdef _WIN32
+  //----< GetFullPathName, for drive relative and device paths >-----
+
+  inline std::string PathResolver::fullPathName(const std::string& path)
+  {
+    std::vector<char> buffer(MAX_PATH);
+    for (;;)
+    {
+      DWORD len = ::GetFullPathNameA(path.c_str(), (DWORD)buffer.size(), buffer.data(), NULL);
+      if (len == 0)
+        return path;
+      if (len < buffer.size())
+        return std::string(buffer.data(), len);
+      buffer.resize(len + 1);
+    }
+  }
+#endif
+  //----< absolute path with ".", "..", and repeated separators removed >
+  /*
+  *  Relative paths are resolved against the cached current directory.
+  */
+  inline std::string PathResolver::resolve(const std::string& path)
+  {
+    size_t links = 0;
+    size_t rootLen = rootLength(path);
+    std::string out;
+    if (rootLen > 0)
+    {
+      out = root(path, rootLen);
+#ifdef _WIN32
+      if (path.size() >= 3 && (path[2] == '?' || path[2] == '.'))
+        return fullPathName(path);             // \\?\ and \\.\ are taken literally
+#endif
+      walk(out, path, rootLen, links);
+      return out;
+    }
+#ifdef _WIN32
+    if (path.size() >= 2 && path[1] == ':')
+      return resolve(fullPathName(path));      // "X:name" is relative to X's own cwd
+    if (!path.empty() && isSeparator(path[0]))
+    {
+      const std::string& cwd = currentDirectory();
+      out = root(cwd, rootLength(cwd));        // "\name" is relative to cwd's drive
+      walk(out, path, 1, links);
+      return out;
+    }
+#endif
+    const std::string& cwd = currentDirectory();
+    out = cwd;
+    if (resolveLinks_)
+    {
+      rootLen = rootLength(cwd);
+      out = root(cwd, rootLen);
+      walk(out, cwd, rootLen, links);
+    }
+    walk(out, path, 0, links);
+    return out;
+  }
+  //----< append name to dir, a path already returned by resolve >---
+  /*
+  *  Only name is examined, so a walker pays for the new component,
+  *  not for the whole path.
+  */
+  inline std::string PathResolver::resolve(const std::string& dir, const std::string& name)
+  {
+    size_t rootLen = rootLength(dir);
+    if (rootLen == 0)
+      return resolve(dir + separator + name);
+    size_t links = 0;
+    std::string out;
+    out.reserve(dir.size() + name.size() + 1);
+    out = dir;
+    while (out.size() > rootLen && isSeparator(out.back()))
+      out.pop_back();
+    walk(out, name, 0, links);
+    return out;
+  }
+  //----< append each component of path, starting at pos, to out >---
+
+  inline void PathResolver::walk(std::string& out, const std::string& path, size_t pos, size_t& links)
+  {
+    while (pos < path.size())
+    {
+      size_t end = pos;
+      while (end < path.size() && !isSeparator(path[end]))
+        ++end;
+      append(out, path.data() + pos, end - pos, links);
+      pos = end + 1;
+    }
+  }
+  //----< apply one component to out >-------------------------------
+  /*
+  *  out holds a root, which may end with a separator, followed by
+  *  components joined by single separators.  ".." never removes the
+  *  root, which is measured only when needed.
+  */
+  inline void PathResolver::append(std::string& out, const char* name, size_t len, size_t& links)
+  {
+    if (len == 0 || (len == 1 && name[0] == '.'))
+      return;
+    if (len == 2 && name[0] == '.' && name[1] == '.')
+    {
+      size_t rootLen = rootLength(out);
+      if (out.size() <= rootLen)
+        return;
+      size_t pos = out.size() - 1;
+      while (pos > 0 && !isSeparator(out[pos]))
+        --pos;
+      out.resize(pos > rootLen ? pos : rootLen);
+      return;
+    }
+    if (!out.empty() && !isSeparator(out.back()))
+      out += separator;
+    out.append(name, len);
+    if (resolveLinks_)
+      followLink(out, links);
+  }
+  //----< replace out with its link target, if out is a link >-------
+  /*
+  *  out's parent is already resolved, so a memo hit finishes out.
+  *  Non-links are memoized too, so each prefix is checked once.
+  */
+  inline void PathResolver::followLink(std::string& out, size_t& links)
+  {
+    auto iter = memo_.find(out);
+    if (iter != memo_.end())
+    {
+      out = iter->second;
+      return;
+    }
+    std::string target;
+    if (!readLink(out, target))
+    {
+      memo_[out] = out;
+      return;
+    }
+    if (++links > maxLinks)
+      return;                                  // a loop; leave out unresolved
+    std::string key = out;
+#ifdef _WIN32
+    out = target;                              // already fully resolved
+#else
+    size_t targetRoot = rootLength(target);
+    if (targetRoot > 0)
+      out = root(target, targetRoot);
+    else
+      append(out, "..", 2, links);             // target is relative to link's directory
+    walk(out, target, targetRoot, links);
+#endif
+    memo_[key] = out;
+  }
+  //----< read target of link at path, false if path isn't a link >--
+
+  inline bool PathResolver::readLink(const std::string& path, std::string& target)
+  {
+#ifdef _WIN32
+    DWORD attribs = ::GetFileAttributesA(path.c_str());
+    if (attribs == INVALID_FILE_ATTRIBUTES || !(attribs & FILE_ATTRIBUTE_REPARSE_POINT))
+      return false;
+    HANDLE hFile = ::CreateFileA(
+      path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+      NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL
+    );
+    if (hFile == INVALID_HANDLE_VALUE)
+      return false;
+    std::vector<char> buffer(MAX_PATH);
+    DWORD len = 0;
+    for (;;)
+    {
+      len = ::GetFinalPathNameByHandleA(hFile, buffer.data(), (DWORD)buffer.size(), FILE_NAME_NORMALIZED);
+      if (len < buffer.size())
+        break;
+      buffer.resize(len + 1);
+    }
+    ::CloseHandle(hFile);
+    if (len == 0)
+      return false;
+    target.assign(buffer.data(), len);
+    if (target.compare(0, 8, "\\\\?\\UNC\\") == 0)
+      target.replace(0, 8, "\\\\");
+    else if (target.compare(0, 4, "\\\\?\\") == 0)
+      target.erase(0, 4);
+    return true;
+#else
+    struct stat info;
+    if (::lstat(path.c_str(), &info) != 0 || !S_ISLNK(info.st_mode))
+      return false;
+    std::vector<char> buffer(info.st_size > 0 ? info.st_size + 1 : 256);
+    for (;;)
+    {
+      ssize_t len = ::readlink(path.c_str(), buffer.data(), buffer.size());
+      if (len < 0)
+        return false;
+      if ((size_t)len < buffer.size())
+      {
+        target.assign(buffer.data(), len);
+        return true;
+      }
+      buffer.resize(2 * buffer.size());
+    }
+#endif
+  }
+}
@@ -0,0 +1,99 @@
+/////////////////////////////////////////////////////////////////////
+// PathTable.cpp - test stub for PathTable                         //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+*  PathTable.h is header only.  This file holds its test stub, which
+*  also needs MappedFile.cpp.
+*/
+
+#ifdef TEST_PATHTABLE
+
+#include "PathTable.h"
+#include "MappedFile.h"
+#include <iostream>
+#include <cstdio>
+
+using namespace FileSystem;
+
+int main()
+{
+  std::cout << "\n  Testing PathTable";
+  std::cout << "\n ===================";
+
+  // a synthetic scan: 3 levels of 12 directories, 200 files in each leaf
+
+  const char sep = PathResolver::separator;
+#ifdef _WIN32
+  std::string root = "C:\\Users\\jim\\repos\\Utilities";
+#else
+  std::string root = "/home/jim/repos/Utilities";
+#endif
+  PathTable table;
+  std::vector<std::string> strings;
+  std::vector<PathTable::Index> leaves;
+  PathTable::Index rootIndex = table.add(root);
+  for (size_t i = 0; i < 12; ++i)
+  {
+    PathTable::Index d1 = table.add(rootIndex, "Project" + std::to_string(i));
+    for (size_t j = 0; j < 12; ++j)
+    {
+      PathTable::Index d2 = table.add(d1, j % 2 ? "Debug" : "Release");
+      d2 = table.add(d2, "obj" + std::to_string(j));
+      for (size_t k = 0; k < 200; ++k)
+      {
+        std::string name = "file" + std::to_string(k) + ".obj";
+        leaves.push_back(table.add(d2, name));
+        strings.push_back(table.path(d2) + sep + name);
+      }
+    }
+  }
+  size_t stringBytes = 0;
+  for (auto& str : strings)
+    stringBytes += sizeof(std::string) + (str.size() < 16 ? 0 : str.capacity() + 1);
+  std::cout << "\n  " << table.size() << " entries, " << table.names() << " distinct names";
+  std::cout << "\n  PathTable uses about " << table.bytes() << " bytes, strings use " << stringBytes;
+
+  bool ok = true;
+  for (size_t i = 0; i < leaves.size(); ++i)
+    ok = ok && table.path(leaves[i]) == strings[i] && table.find(strings[i]) == leaves[i];
+  std::cout << "\n  path and find agree with strings: " << (ok ? "yes" : "no");
+  std::cout << "\n  " << table.path(leaves.back()) << " has depth " << table.depth(leaves.back());
+  std::cout << "\n  find(root + \"/missing\") " << (table.find(root + sep + "missing") == PathTable::npos ? "is npos" : "found - error");
+  std::cout << "\n  adding an existing path returns its index: "
+    << (table.add(strings[7]) == leaves[7] ? "yes" : "no");
+
+  std::string fileSpec = "PathTableTest.ptbl";
+  if (!table.save(fileSpec))
+  {
+    std::cout << "\n  can't save " << fileSpec << "\n\n";
+    return 1;
+  }
+  {
+    MappedFile mf(fileSpec);
+    PathTableView view(mf.data(), mf.size());
+    std::cout << "\n\n  mapped " << mf.size() << " byte image, view is " << (view.good() ? "good" : "bad");
+    bool viewOk = view.good() && view.size() == table.size();
+    for (size_t i = 0; viewOk && i < leaves.size(); ++i)
+      viewOk = view.path(leaves[i]) == strings[i] && view.find(strings[i]) == leaves[i];
+    std::cout << "\n  view's path and find agree: " << (viewOk ? "yes" : "no");
+
+    PathTable loaded;
+    bool loadOk = loaded.load(mf.data(), mf.size()) && loaded.size() == table.size();
+    for (size_t i = 0; loadOk && i < leaves.size(); ++i)
+      loadOk = loaded.find(strings[i]) == leaves[i];
+    std::cout << "\n  loaded table keeps indices: " << (loadOk ? "yes" : "no");
+
+    PathTableView bad("not a table", 11);
+    std::cout << "\n  view of garbage is " << (bad.good() ? "good - error" : "not good");
+  }
+  std::remove(fileSpec.c_str());
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,634 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PathTable.h - compact store of many paths as a tree of names    //
+// ver 1.1                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* PathTable holds paths, e.g., the results of a directory scan, as
+* entries of (parent index, name index).  Each distinct name is stored
+* once in a NameArena, so a directory's path is stored once, not once
+* per file below it, and names repeated across directories, e.g.,
+* "Debug" or "index.html", are shared.  An entry costs 8 bytes plus
+* about 16 bytes of hash slots, and a name costs its chars plus 16.
+*
+* Indices are dense and stable, so applications keep per path data,
+* e.g., sizes or dates, in vectors indexed by PathTable::Index.
+*
+* - add(path) adds path's root and every component, returning the
+*   leaf's index.  A walker that has a directory's index adds its
+*   children with add(dirIndex, name), which is one hash probe.
+* - path(i) rebuilds the full path in O(depth), walking parents.
+* - find(path) looks up a path, one hash probe per component.
+*
+* save() writes a flat image that PathTableView reads in place, e.g.,
+* from a MappedFile, with no parsing or allocation.  The image holds a
+* sorted index, so the view's find is a binary search per component.
+* The view checks every entry, name, and index once when constructed,
+* so a corrupt or hostile image makes good() false rather than causing
+* out of bounds reads or endless parent walks.
+* load() rebuilds a PathTable from an image, preserving indices.
+*
+* Paths are split at separators, so store resolved paths, e.g., from
+* PathResolver, or "a/../b" and "b" are different entries.
+*
+* Public Interface:
+* -----------------
+*   PathTable table;
+*   PathTable::Index dir = table.add("/home/jim/src");
+*   PathTable::Index file = table.add(dir, "main.cpp");
+*   std::string path = table.path(file);          // "/home/jim/src/main.cpp"
+*   if (table.find("/home/jim/src/main.cpp") != PathTable::npos) ...
+*   table.save("scan.ptbl");
+*   MappedFile mf("scan.ptbl");
+*   PathTableView view(mf.data(), mf.size());
+*   std::string same = view.path(file);
+*
+* Required Files:
+* ---------------
+*   PathTable.h, PathTable.cpp        // PathTable.cpp just for testing
+*   NameArena.h, PathResolver.h
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - PathTableView validates each entry's parent and name, each name's
+*   span, and the sorted index, not just the header and total size
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include "NameArena.h"
+#include "PathResolver.h"
+
+namespace FileSystem
+{
+  namespace PathTableDetail
+  {
+    using Index = uint32_t;
+    const Index npos = UINT32_MAX;
+
+    struct Entry
+    {
+      Index parent;   // npos for roots
+      Index name;     // index into names
+    };
+
+    struct NameEntry
+    {
+      uint32_t offset;
+      uint32_t length;
+    };
+
+    struct Header
+    {
+      char magic[4];
+      uint32_t version;
+      uint32_t numEntries;
+      uint32_t numNames;
+      uint64_t numChars;
+    };
+    const char magic[4] = { 'P', 'T', 'B', 'L' };
+    const uint32_t version = 1;
+
+    //----< FNV-1a hash of name >------------------------------------
+
+    inline uint32_t hashName(const char* name, size_t len)
+    {
+      uint32_t hash = 2166136261u;
+      for (size_t i = 0; i < len; ++i)
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+      return hash;
+    }
+    //----< hash of (parent, name) key >-----------------------------
+
+    inline uint32_t hashChild(Index parent, Index name)
+    {
+      uint64_t key = ((uint64_t)parent << 32) | name;
+      key ^= key >> 33;
+      key *= 0xff51afd7ed558ccdull;
+      key ^= key >> 33;
+      return (uint32_t)key;
+    }
+    //----< split path into root and components, calling add for each >
+    /*
+    *  The root, if any, is passed with preferred separators.  Empty
+    *  components, from repeated separators, are skipped.  Stops and
+    *  returns npos if add does.
+    */
+    template<typename AddFn>
+    Index forEachComponent(const std::string& path, AddFn add)
+    {
+      Index index = npos;
+      size_t rootLen = PathResolver::rootLength(path);
+      if (rootLen > 0)
+      {
+        std::string root = path.substr(0, rootLen);
+        for (auto& ch : root)
+        {
+          if (PathResolver::isSeparator(ch))
+            ch = PathResolver::separator;
+        }
+        if ((index = add(index, root.data(), root.size())) == npos)
+          return npos;
+      }
+      size_t pos = rootLen;
+      while (pos < path.size())
+      {
+        size_t end = pos;
+        while (end < path.size() && !PathResolver::isSeparator(path[end]))
+          ++end;
+        if (end > pos && (index = add(index, path.data() + pos, end - pos)) == npos)
+          return npos;
+        pos = end + 1;
+      }
+      return index;
+    }
+    //----< join names from root to entry i, into out >--------------
+    /*
+    *  Walks parents twice, once to size out and once to fill it from
+    *  the back, so nothing but out is allocated.
+    */
+    template<typename Table>
+    void buildPath(const Table& table, Index i, std::string& out)
+    {
+      size_t len = 0;
+      for (Index j = i; j != npos; j = table.parent(j))
+      {
+        len += table.nameLength(j);
+        Index p = table.parent(j);
+        if (p != npos && !PathResolver::isSeparator(table.name(p)[table.nameLength(p) - 1]))
+          ++len;
+      }
+      out.resize(len);
+      size_t pos = len;
+      for (Index j = i; j != npos; j = table.parent(j))
+      {
+        size_t nameLen = table.nameLength(j);
+        pos -= nameLen;
+        std::memcpy(&out[pos], table.name(j), nameLen);
+        Index p = table.parent(j);
+        if (p != npos && !PathResolver::isSeparator(table.name(p)[table.nameLength(p) - 1]))
+          out[--pos] = PathResolver::separator;
+      }
+    }
+    //----< number of entries from root to i, inclusive >------------
+
+    template<typename Table>
+    size_t depth(const Table& table, Index i)
+    {
+      size_t count = 0;
+      for (; i != npos; i = table.parent(i))
+        ++count;
+      return count;
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // IndexSet - open addressing hash set of indices
+    // - the caller supplies hashes and equality, so keys stay in the
+    //   table's own arrays; a slot is 8 bytes
+
+    class IndexSet
+    {
+    public:
+      template<typename Eq>
+      Index find(uint32_t hash, Eq eq) const
+      {
+        if (slots_.empty())
+          return npos;
+        size_t mask = slots_.size() - 1;
+        for (size_t i = hash & mask; ; i = (i + 1) & mask)
+        {
+          const Slot& slot = slots_[i];
+          if (slot.index == npos)
+            return npos;
+          if (slot.hash == hash && eq(slot.index))
+            return slot.index;
+        }
+      }
+      void insert(uint32_t hash, Index index)  // index must not be present
+      {
+        if (2 * (count_ + 1) > slots_.size())
+          rehash(slots_.empty() ? 16 : 2 * slots_.size());
+        place(hash, index);
+        ++count_;
+      }
+      void reserve(size_t count)
+      {
+        size_t size = 16;
+        while (size < 2 * count)
+          size *= 2;
+        if (size > slots_.size())
+          rehash(size);
+      }
+      void clear()
+      {
+        slots_.clear();
+        count_ = 0;
+      }
+      size_t bytes() const { return slots_.capacity() * sizeof(Slot); }
+    private:
+      struct Slot
+      {
+        Index index;
+        uint32_t hash;
+      };
+      void place(uint32_t hash, Index index)
+      {
+        size_t mask = slots_.size() - 1;
+        size_t i = hash & mask;
+        while (slots_[i].index != npos)
+          i = (i + 1) & mask;
+        slots_[i] = Slot{ index, hash };
+      }
+      void rehash(size_t size)
+      {
+        std::vector<Slot> old(size, Slot{ npos, 0 });
+        old.swap(slots_);
+        for (auto& slot : old)
+        {
+          if (slot.index != npos)
+            place(slot.hash, slot.index);
+        }
+      }
+      std::vector<Slot> slots_;
+      size_t count_ = 0;
+    };
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // PathTable - mutable table of paths
+
+  class PathTable
+  {
+  public:
+    using Index = PathTableDetail::Index;
+    static const Index npos = PathTableDetail::npos;
+
+    Index add(const std::string& path);
+    Index add(Index parent, const std::string& name);
+    Index add(Index parent, const char* name, size_t len);
+    Index find(const std::string& path) const;
+    Index find(Index parent, const char* name, size_t len) const;
+
+    size_t size() const;
+    Index parent(Index i) const;
+    const char* name(Index i) const;
+    size_t nameLength(Index i) const;
+    std::string path(Index i) const;
+    void path(Index i, std::string& out) const;
+    size_t depth(Index i) const;
+
+    size_t names() const;
+    size_t bytes() const;
+    void reserve(size_t numEntries, size_t numNames, size_t numChars);
+    void clear();
+
+    void save(std::ostream& out) const;
+    bool save(const std::string& fileSpec) const;
+    bool load(const char* data, size_t size);
+  private:
+    Index intern(const char* name, size_t len);
+
+    std::vector<PathTableDetail::Entry> entries_;
+    NameArena names_;                       // each distinct name once
+    PathTableDetail::IndexSet nameSet_;     // name chars -> names_ index
+    PathTableDetail::IndexSet childSet_;    // (parent, name) -> entries_ index
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // PathTableView - read-only table over an image written by save()
+  // - the image must stay alive, and 4 byte aligned, while in use
+
+  class PathTableView
+  {
+  public:
+    using Index = PathTableDetail::Index;
+    static const Index npos = PathTableDetail::npos;
+
+    PathTableView(const char* data = nullptr, size_t size = 0);
+    bool good() const;
+
+    Index find(const std::string& path) const;
+    Index find(Index parent, const char* name, size_t len) const;
+
+    size_t size() const;
+    Index parent(Index i) const;
+    const char* name(Index i) const;
+    size_t nameLength(Index i) const;
+    std::string path(Index i) const;
+    void path(Index i, std::string& out) const;
+    size_t depth(Index i) const;
+    size_t names() const;
+  private:
+    int compare(Index entry, Index parent, const char* name, size_t len) const;
+
+    const PathTableDetail::Entry* entries_ = nullptr;
+    const PathTableDetail::NameEntry* names_ = nullptr;
+    const Index* order_ = nullptr;          // entries sorted by (parent, name)
+    const char* chars_ = nullptr;
+    size_t numEntries_ = 0;
+    size_t numNames_ = 0;
+    bool good_ = false;
+  };
+
+  //----< add path, its root, and its components; return leaf's index >
+
+  inline PathTable::Index PathTable::add(const std::string& path)
+  {
+    return PathTableDetail::forEachComponent(path, [this](Index parent, const char* name, size_t len) {
+      return add(parent, name, len);
+    });
+  }
+  //----< add name below parent, or find it if already present >-----
+  /*
+  *  parent is npos for a root, e.g., "/" or "C:\", or for the first
+  *  component of a relative path.
+  */
+  inline PathTable::Index PathTable::add(Index parent, const char* name, size_t len)
+  {
+    Index nameIndex = intern(name, len);
+    uint32_t hash = PathTableDetail::hashChild(parent, nameIndex);
+    Index found = childSet_.find(hash, [&](Index i) {
+      return entries_[i].parent == parent && entries_[i].name == nameIndex;
+    });
+    if (found != npos)
+      return found;
+    if (entries_.size() >= npos)
+      throw std::length_error("PathTable capacity exceeded");
+    entries_.push_back(PathTableDetail::Entry{ parent, nameIndex });
+    Index index = (Index)(entries_.size() - 1);
+    childSet_.insert(hash, index);
+    return index;
+  }
+
+  inline PathTable::Index PathTable::add(Index parent, const std::string& name)
+  {
+    return add(parent, name.data(), name.size());
+  }
+  //----< index of name in names_, adding it if new >----------------
+
+  inline PathTable::Index PathTable::intern(const char* name, size_t len)
+  {
+    uint32_t hash = PathTableDetail::hashName(name, len);
+    Index found = nameSet_.find(hash, [&](Index i) {
+      return names_.length(i) == len && std::memcmp(names_.c_str(i), name, len) == 0;
+    });
+    if (found != npos)
+      return found;
+    Index index = (Index)names_.add(name, len);
+    nameSet_.insert(hash, index);
+    return index;
+  }
+  //----< index of path, or npos >-----------------------------------
+
+  inline PathTable::Index PathTable::find(const std::string& path) const
+  {
+    return PathTableDetail::forEachComponent(path, [this](Index parent, const char* name, size_t len) {
+      return find(parent, name, len);
+    });
+  }
+  //----< index of name below parent, or npos >----------------------
+
+  inline PathTable::Index PathTable::find(Index parent, const char* name, size_t len) const
+  {
+    uint32_t hashName = PathTableDetail::hashName(name, len);
+    Index nameIndex = nameSet_.find(hashName, [&](Index i) {
+      return names_.length(i) == len && std::memcmp(names_.c_str(i), name, len) == 0;
+    });
+    if (nameIndex == npos)
+      return npos;
+    return childSet_.find(PathTableDetail::hashChild(parent, nameIndex), [&](Index i) {
+      return entries_[i].parent == parent && entries_[i].name == nameIndex;
+    });
+  }
+
+  inline size_t PathTable::size() const { return entries_.size(); }
+  inline PathTable::Index PathTable::parent(Index i) const { return entries_[i].parent; }
+  inline const char* PathTable::name(Index i) const { return names_.c_str(entries_[i].name); }
+  inline size_t PathTable::nameLength(Index i) const { return names_.length(entries_[i].name); }
+  inline size_t PathTable::names() const { return names_.size(); }
+
+  //----< full path of entry i >-------------------------------------
+
+  inline std::string PathTable::path(Index i) const
+  {
+    std::string out;
+    PathTableDetail::buildPath(*this, i, out);
+    return out;
+  }
+
+  inline void PathTable::path(Index i, std::string& out) const
+  {
+    PathTableDetail::buildPath(*this, i, out);
+  }
+
+  inline size_t PathTable::depth(Index i) const
+  {
+    return PathTableDetail::depth(*this, i);
+  }
+  //----< approximate heap bytes used >------------------------------
+
+  inline size_t PathTable::bytes() const
+  {
+    return entries_.capacity() * sizeof(PathTableDetail::Entry)
+      + names_.chars() + names_.size() * sizeof(PathTableDetail::NameEntry)
+      + nameSet_.bytes() + childSet_.bytes();
+  }
+
+  inline void PathTable::reserve(size_t numEntries, size_t numNames, size_t numChars)
+  {
+    entries_.reserve(numEntries);
+    names_.reserve(numNames, numChars);
+    nameSet_.reserve(numNames);
+    childSet_.reserve(numEntries);
+  }
+
+  inline void PathTable::clear()
+  {
+    entries_.clear();
+    names_.reset();
+    nameSet_.clear();
+    childSet_.clear();
+  }
+  //----< write image readable by PathTableView and load() >---------
+  /*
+  *  Layout: Header, Entry[numEntries], NameEntry[numNames],
+  *  Index order[numEntries], then numChars of '\0' terminated names.
+  *  Integers are in native byte order.
+  */
+  inline void PathTable::save(std::ostream& out) const
+  {
+    using namespace PathTableDetail;
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.numEntries = (uint32_t)entries_.size();
+    header.numNames = (uint32_t)names_.size();
+    header.numChars = names_.chars();
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)entries_.data(), entries_.size() * sizeof(Entry));
+
+    std::vector<NameEntry> nameEntries(names_.size());
+    for (size_t i = 0; i < names_.size(); ++i)
+      nameEntries[i] = NameEntry{ (uint32_t)(names_.c_str(i) - names_.c_str(0)), (uint32_t)names_.length(i) };
+    out.write((const char*)nameEntries.data(), nameEntries.size() * sizeof(NameEntry));
+
+    std::vector<Index> order(entries_.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = (Index)i;
+    std::sort(order.begin(), order.end(), [this](Index i, Index j) {
+      if (entries_[i].parent != entries_[j].parent)
+        return entries_[i].parent < entries_[j].parent;
+      return names_.compare(entries_[i].name, entries_[j].name) < 0;
+    });
+    out.write((const char*)order.data(), order.size() * sizeof(Index));
+    if (names_.size() > 0)
+      out.write(names_.c_str(0), names_.chars());
+  }
+
+  inline bool PathTable::save(const std::string& fileSpec) const
+  {
+    std::ofstream out(fileSpec, std::ios::binary);
+    if (!out.good())
+      return false;
+    save(out);
+    return out.good();
+  }
+  //----< replace contents with an image written by save() >---------
+  /*
+  *  Parents always precede their children, so adding entries in
+  *  order reproduces the saved indices.
+  */
+  inline bool PathTable::load(const char* data, size_t size)
+  {
+    PathTableView view(data, size);
+    if (!view.good())
+      return false;
+    clear();
+    reserve(view.size(), view.names(), size);
+    for (Index i = 0; i < view.size(); ++i)
+      add(view.parent(i), view.name(i), view.nameLength(i));
+    return true;
+  }
+
+  //----< validate image and locate its arrays >---------------------
+  /*
+  *  Parents must precede their children, as save() writes them, which
+  *  also rules out parent cycles.  Each name must lie inside the chars
+  *  and be '\0' terminated, and the sorted index must hold entries.
+  */
+  inline PathTableView::PathTableView(const char* data, size_t size)
+  {
+    using namespace PathTableDetail;
+    if (data == nullptr || size < sizeof(Header))
+      return;
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version)
+      return;
+    uint64_t need = sizeof(Header)
+      + (uint64_t)header.numEntries * (sizeof(Entry) + sizeof(Index))
+      + (uint64_t)header.numNames * sizeof(NameEntry) + header.numChars;
+    if (need > size)
+      return;
+    const char* pos = data + sizeof(Header);
+    entries_ = (const Entry*)pos;
+    pos += header.numEntries * sizeof(Entry);
+    names_ = (const NameEntry*)pos;
+    pos += header.numNames * sizeof(NameEntry);
+    order_ = (const Index*)pos;
+    pos += header.numEntries * sizeof(Index);
+    chars_ = pos;
+
+    for (uint32_t i = 0; i < header.numEntries; ++i)
+    {
+      if ((entries_[i].parent != npos && entries_[i].parent >= i) ||
+        entries_[i].name >= header.numNames || order_[i] >= header.numEntries)
+        return;
+    }
+    for (uint32_t i = 0; i < header.numNames; ++i)
+    {
+      uint64_t end = (uint64_t)names_[i].offset + names_[i].length;
+      if (end >= header.numChars || chars_[end] != '\0')
+        return;
+    }
+    numEntries_ = header.numEntries;
+    numNames_ = header.numNames;
+    good_ = true;
+  }
+
+  inline bool PathTableView::good() const { return good_; }
+  inline size_t PathTableView::size() const { return numEntries_; }
+  inline size_t PathTableView::names() const { return numNames_; }
+  inline PathTableView::Index PathTableView::parent(Index i) const { return entries_[i].parent; }
+  inline const char* PathTableView::name(Index i) const { return chars_ + names_[entries_[i].name].offset; }
+  inline size_t PathTableView::nameLength(Index i) const { return names_[entries_[i].name].length; }
+
+  inline std::string PathTableView::path(Index i) const
+  {
+    std::string out;
+    PathTableDetail::buildPath(*this, i, out);
+    return out;
+  }
+
+  inline void PathTableView::path(Index i, std::string& out) const
+  {
+    PathTableDetail::buildPath(*this, i, out);
+  }
+
+  inline size_t PathTableView::depth(Index i) const
+  {
+    return PathTableDetail::depth(*this, i);
+  }
+  //----< order entry against (parent, name), as save() sorted them >
+
+  inline int PathTableView::compare(Index entry, Index parent, const char* name, size_t len) const
+  {
+    if (entries_[entry].parent != parent)
+      return entries_[entry].parent < parent ? -1 : 1;
+    size_t entryLen = nameLength(entry);
+    int cmp = std::memcmp(this->name(entry), name, entryLen < len ? entryLen : len);
+    if (cmp != 0)
+      return cmp;
+    return entryLen < len ? -1 : (entryLen > len ? 1 : 0);
+  }
+  //----< index of name below parent, or npos, by binary search >----
+
+  inline PathTableView::Index PathTableView::find(Index parent, const char* name, size_t len) const
+  {
+    size_t lo = 0, hi = numEntries_;
+    while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      int cmp = compare(order_[mid], parent, name, len);
+      if (cmp == 0)
+        return order_[mid];
+      if (cmp < 0)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return npos;
+  }
+
+  inline PathTableView::Index PathTableView::find(const std::string& path) const
+  {
+    return PathTableDetail::forEachComponent(path, [this](Index parent, const char* name, size_t len) {
+      return find(parent, name, len);
+    });
+  }
+}
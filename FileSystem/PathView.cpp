@@ -0,0 +1,68 @@
+/////////////////////////////////////////////////////////////////////
+// PathView.cpp - test stub for PathView                           //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+*  PathView.h is header only.  This file holds its test stub.
+*/
+
+#ifdef TEST_PATHVIEW
+
+#include "PathView.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace FileSystem;
+
+void show(const std::string& path)
+{
+  PathView view(path);
+  std::cout << "\n  " << std::left << std::setw(24) << ("\"" + path + "\"")
+    << " dir \"" << view.dir() << "\", name \"" << view.name()
+    << "\", stem \"" << view.stem() << "\", ext \"" << view.ext() << "\"";
+}
+
+int main()
+{
+  std::cout << "\n  Testing PathView";
+  std::cout << "\n ==================";
+
+  std::vector<std::string> paths{
+    "/usr/lib", "/a.txt", "archive.tar.gz", ".gitignore", "src/", "..", "a//b.c"
+  };
+#ifdef _WIN32
+  paths.push_back("C:\\src\\main.cpp");
+  paths.push_back("C:\\boot.ini");
+  paths.push_back("mixed/dir\\name.h");
+#endif
+  for (auto& path : paths)
+    show(path);
+
+  std::cout << "\n\n  join";
+  std::cout << "\n ------";
+  std::string buffer;
+  PathView::join("/usr/lib", "libc.so", buffer);
+  std::cout << "\n  join(\"/usr/lib\", \"libc.so\") = " << buffer;
+  PathView::join("/", "etc", buffer);
+  std::cout << "\n  join(\"/\", \"etc\") = " << buffer;
+  PathView::join("..\\src", "main.cpp", buffer);
+  std::cout << "\n  join(\"..\\\\src\", \"main.cpp\") = " << buffer;
+  PathView::join("", "alone.txt", buffer);
+  std::cout << "\n  join(\"\", \"alone.txt\") = " << buffer;
+
+  std::string fileSpec = "/home/jim/src/FileSystem.CPP";
+  PathView view(fileSpec);
+  std::cout << "\n\n  \"" << fileSpec << "\" is C++ source: "
+    << (view.ext().equalsNoCase("cpp") ? "yes" : "no");
+  PathView::join(view.dir(), "FileSystem.h", buffer);
+  std::cout << "\n  its header is " << buffer;
+  std::cout << "\n\n";
+  return 0;
+}
+#endif
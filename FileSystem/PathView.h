@@ -0,0 +1,212 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// PathView.h - parse a path once, without allocating             //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* PathView scans a path once, from its end, and records where its
+* directory, name, stem, and extension are.  The parts are returned
+* as PathParts, pointer and length pairs into the caller's string,
+* so classifying a file by name or extension allocates nothing.
+*
+*   "C:\src\main.cpp"   dir "C:\src"  name "main.cpp"  stem "main"  ext "cpp"
+*   "/usr/lib"          dir "/usr"    name "lib"       stem "lib"   ext ""
+*   "/a.txt"            dir "/"       name "a.txt"     stem "a"     ext "txt"
+*   "archive.tar.gz"    dir ""        name "archive.tar.gz"  stem "archive.tar"  ext "gz"
+*
+* Separators are PathResolver::isSeparator's: '/' and backslash on
+* Windows, where a path may mix them, and only '/' elsewhere, where a
+* backslash is an ordinary character of a name.  So the "C:\src"
+* example above holds only on Windows.
+*
+* A root keeps its separator, so dir() of "/a" is "/".  ext() follows
+* the last '.' of the name, so ".gitignore" has stem "" and ext
+* "gitignore", as Path::getExt has always reported.  "." and ".."
+* have no extension.
+*
+* join(dir, name, out) writes dir and name, with a separator between
+* them if dir doesn't end with one, into out, reusing its capacity.
+* The separator matches the style of dir, '/' if dir has none.
+*
+* PathPart stands in for C++17's string_view, which this code base
+* can't yet assume, and converts to one where it is available.
+*
+* Public Interface:
+* -----------------
+*   PathView view(fileSpec);                 // fileSpec must outlive view
+*   if (view.ext().equalsNoCase("cpp")) ...
+*   std::string name = view.name().str();    // allocates only if asked
+*   std::string buffer;
+*   PathView::join(dir, view.name(), buffer);
+*
+* Required Files:
+* ---------------
+*   PathView.h, PathView.cpp      // PathView.cpp just for testing
+*   PathResolver.h, CaseFold.h
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <cstring>
+#include <ostream>
+#include "PathResolver.h"
+#include "CaseFold.h"
+
+#if defined(__has_include)
+#if __has_include(<string_view>) && __cplusplus >= 201703L
+#include <string_view>
+#define PATHVIEW_HAS_STRING_VIEW
+#endif
+#endif
+#if defined(_MSVC_LANG) && _MSVC_LANG >= 201703L && !defined(PATHVIEW_HAS_STRING_VIEW)
+#include <string_view>
+#define PATHVIEW_HAS_STRING_VIEW
+#endif
+
+namespace FileSystem
+{
+  /////////////////////////////////////////////////////////////////////
+  // PathPart - chars of a path, not owned
+
+  class PathPart
+  {
+  public:
+    PathPart() {}
+    PathPart(const char* data, size_t size) : data_(data), size_(size) {}
+    PathPart(const std::string& str) : data_(str.data()), size_(str.size()) {}
+    PathPart(const char* str) : data_(str), size_(std::strlen(str)) {}
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+    char operator[](size_t i) const { return data_[i]; }
+    char back() const { return data_[size_ - 1]; }
+
+    std::string str() const { return std::string(data_, size_); }
+    void assignTo(std::string& out) const { out.assign(data_, size_); }
+#ifdef PATHVIEW_HAS_STRING_VIEW
+    operator std::string_view() const { return std::string_view(data_, size_); }
+#endif
+
+    bool operator==(const PathPart& other) const
+    {
+      return size_ == other.size_ && std::memcmp(data_, other.data_, size_) == 0;
+    }
+    bool operator!=(const PathPart& other) const { return !(*this == other); }
+    bool equalsNoCase(const PathPart& other) const
+    {
+      return FileSystem::equalsNoCase(data_, size_, other.data_, other.size_);
+    }
+  private:
+    const char* data_ = "";
+    size_t size_ = 0;
+  };
+
+  inline std::ostream& operator<<(std::ostream& out, const PathPart& part)
+  {
+    return out.write(part.data(), part.size());
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // PathView - one pass decomposition of a path
+
+  class PathView
+  {
+  public:
+    PathView(const char* path, size_t len);
+    PathView(const std::string& path);
+    PathView(std::string&&) = delete;  // would point into a temporary
+
+    PathPart path() const;
+    PathPart dir() const;
+    PathPart dirWithSeparator() const;
+    PathPart name() const;
+    PathPart stem() const;
+    PathPart ext() const;
+    bool hasDir() const;
+    bool hasExt() const;
+
+    static void join(const PathPart& dir, const PathPart& name, std::string& out);
+  private:
+    const char* path_;
+    size_t len_;
+    size_t nameStart_;  // one past last separator, 0 if none
+    size_t dirEnd_;     // end of dir, keeping a root's separator
+    size_t dot_;        // last '.' in name, len_ if none
+  };
+
+  //----< scan from the end for the last separator and the last dot >
+
+  inline PathView::PathView(const char* path, size_t len)
+    : path_(path), len_(len), nameStart_(0), dirEnd_(0), dot_(len)
+  {
+    size_t i = len;
+    while (i > 0)
+    {
+      char ch = path[i - 1];
+      if (PathResolver::isSeparator(ch))
+      {
+        nameStart_ = i;
+        break;
+      }
+      if (ch == '.' && dot_ == len)
+        dot_ = i - 1;
+      --i;
+    }
+    size_t nameLen = len - nameStart_;
+    if ((nameLen == 1 || nameLen == 2) && path[nameStart_] == '.' && path[len - 1] == '.')
+      dot_ = len;                                   // "." and ".." have no extension
+    if (nameStart_ == 0)
+      return;
+    dirEnd_ = nameStart_ - 1;
+    while (dirEnd_ > 0 && PathResolver::isSeparator(path[dirEnd_ - 1]))
+      --dirEnd_;                                    // "a//b" has dir "a"
+    bool isRoot = dirEnd_ == 0 || (dirEnd_ == 2 && path[1] == ':');
+    if (isRoot)
+      ++dirEnd_;                                    // "/" or "C:\"
+  }
+
+  inline PathView::PathView(const std::string& path) : PathView(path.data(), path.size()) {}
+
+  inline PathPart PathView::path() const { return PathPart(path_, len_); }
+  inline PathPart PathView::dir() const { return PathPart(path_, dirEnd_); }
+  inline PathPart PathView::dirWithSeparator() const { return PathPart(path_, nameStart_); }
+  inline PathPart PathView::name() const { return PathPart(path_ + nameStart_, len_ - nameStart_); }
+  inline PathPart PathView::stem() const { return PathPart(path_ + nameStart_, dot_ - nameStart_); }
+  inline bool PathView::hasDir() const { return nameStart_ > 0; }
+  inline bool PathView::hasExt() const { return dot_ < len_; }
+
+  inline PathPart PathView::ext() const
+  {
+    return hasExt() ? PathPart(path_ + dot_ + 1, len_ - dot_ - 1) : PathPart();
+  }
+  //----< write dir, a separator if needed, and name into out >-------
+
+  inline void PathView::join(const PathPart& dir, const PathPart& name, std::string& out)
+  {
+    out.clear();
+    out.reserve(dir.size() + name.size() + 1);
+    out.append(dir.data(), dir.size());
+    if (!dir.empty() && !PathResolver::isSeparator(dir.back()))
+    {
+      char sep = '/';
+      if (std::memchr(dir.data(), '/', dir.size()) == nullptr && std::memchr(dir.data(), '\\', dir.size()) != nullptr)
+        sep = '\\';
+      out += sep;
+    }
+    out.append(name.data(), name.size());
+  }
+}
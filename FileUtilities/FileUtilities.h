@@ -1,7 +1,7 @@
 #pragma once
 ///////////////////////////////////////////////////////////////////////
 // FileUtilities.h - facilities for interacting with files           //
-// ver 1.1                                                           //
+// ver 1.2                                                           //
 // Language:    C++, Visual Studio 2017                              //
 // Application: Project #1 - F2018, CSE687 - Object Oriented Design  //
 // Author:      Jim Fawcett, Syracuse University, CST 4-187          //
@@ -10,21 +10,39 @@
 /*
 * Package Operations:
 * -------------------
-* This package provides three global functions:
+* This package provides four global functions:
 * - displayFileContents(msg, fileSpec, ostream)
 *   Writes msg, then file contents to ostream
 * - showDirContents(path, msg, patterns, ostream)
 *   Display msg, then contents of directory path matching patterns.
+* - streamDirContents(path, msg, patterns, ostream, order)
+*   Same display as showDirContents, but holds names in a compact
+*   NameArena, sorts an index of name offsets, omits files matched
+*   by more than one pattern, and writes through a BufferedWriter.
+*   Memory still grows with the number of names, but by their chars
+*   plus eight bytes each, rather than a std::string per name, so
+*   very large flat directories fit.  Nothing spills to disk.
 * - showFileLines(path, startLine, endLine, msg, ostream)
 *   Display msg, then segment of file between startLine and endLine.
+* and classes:
+* - BufferedWriter
+*   Collects output in a fixed size buffer, writing to its ostream
+*   only when the buffer fills, on flush(), and on destruction.
 *
 * Required Files:
 * ---------------
 *   FileUtilities.h
 *   StringUtilities.h
+*   FileSystem.h, FileSystem.cpp, NameArena.h, PathView.h
 *
 * Maintenance History:
 * --------------------
+* ver 1.2 : 19 Oct 2026
+* - added streamDirContents and BufferedWriter
+* - implemented secondary sort on extensions, SortOrder::nameThenExt
+* - streamDirContents fills its NameArena directly from Directory
+* - streamDirContents defaults to SortOrder::name, as showDirContents
+*   sorts, and nameThenExt splits names as PathView does
 * ver 1.1 : 11 Oct 2018
 * - moved some definitions to Environment.h
 * ver 1.0 : 27 Sep 2018
@@ -37,7 +55,7 @@
 *
 * Planned Additions and Changes:
 * ------------------------------
-* - implement secondary sort on extensions in showDirContents
+* - none yet
 */
 
 #include <iostream>
@@ -48,8 +66,12 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cstring>
+#include <cstdint>
 #include "../StringUtilities/StringUtilities.h"
 #include "../FileSystem/FileSystem.h"
+#include "../FileSystem/NameArena.h"
+#include "../FileSystem/PathView.h"
 #include "../UtilitiesEnvironment/Environment.h"
 
 namespace Utilities
@@ -130,6 +152,135 @@ namespace Utilities
     out << "\n";
     return true;
   }
+  ///////////////////////////////////////////////////////////////////
+  // BufferedWriter class
+  // - accumulates output in a fixed size buffer
+  // - one write to the underlying stream per bufferful
+
+  class BufferedWriter
+  {
+  public:
+    BufferedWriter(std::ostream& out, size_t bufSize = 1 << 16)
+      : out_(out), buffer_(bufSize > 0 ? bufSize : 1) {}
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+    ~BufferedWriter() { flush(); }
+
+    void write(const char* pChars, size_t len);
+    void write(const std::string& str) { write(str.data(), str.size()); }
+    void flush();
+  private:
+    std::ostream& out_;
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+  };
+  //----< append chars, writing out buffer whenever it fills >-------
+
+  inline void BufferedWriter::write(const char* pChars, size_t len)
+  {
+    while (len > 0)
+    {
+      if (used_ == buffer_.size())
+        flush();
+      size_t count = buffer_.size() - used_;
+      if (count > len)
+        count = len;
+      std::memcpy(buffer_.data() + used_, pChars, count);
+      used_ += count;
+      pChars += count;
+      len -= count;
+    }
+  }
+  //----< send buffered chars to stream >----------------------------
+
+  inline void BufferedWriter::flush()
+  {
+    if (used_ > 0)
+      out_.write(buffer_.data(), used_);
+    used_ = 0;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // streamDirContents function
+  // - SortOrder::name sorts on the full file name, like showDirContents
+  // - SortOrder::nameThenExt sorts on name without extension, then
+  //   on extension, so foo.cpp and foo.h are adjacent.  Stem and
+  //   extension are PathView's, so .gitignore has stem "" and
+  //   extension "gitignore".
+
+  enum class SortOrder { name, nameThenExt };
+
+  //----< compare names by stem, then by extension >-----------------
+
+  inline int compareStemThenExt(const char* name1, size_t len1, const char* name2, size_t len2)
+  {
+    auto stemLength = [](const char* name, size_t len) {
+      return FileSystem::PathView(name, len).stem().size();
+    };
+    auto compare = [](const char* s1, size_t n1, const char* s2, size_t n2) {
+      int cmp = std::memcmp(s1, s2, n1 < n2 ? n1 : n2);
+      if (cmp != 0)
+        return cmp;
+      return n1 < n2 ? -1 : (n1 > n2 ? 1 : 0);
+    };
+    size_t stem1 = stemLength(name1, len1);
+    size_t stem2 = stemLength(name2, len2);
+    int cmp = compare(name1, stem1, name2, stem2);
+    if (cmp != 0)
+      return cmp;
+    return compare(name1 + stem1, len1 - stem1, name2 + stem2, len2 - stem2);
+  }
+  //----< show directory contents without a string per name >--------
+
+  inline bool streamDirContents(
+    const PathStr& path,
+    const Message& msg = "",
+    const Patterns& patterns = Patterns(),
+    std::ostream& out = std::cout,
+    SortOrder order = SortOrder::name
+  )
+  {
+    if (msg.size() > 0)
+      Utilities::title(msg, out);
+    out << "\n  " << FileSystem::Path::getFullFileSpec(path);
+    if (!FileSystem::Directory::exists(path))
+    {
+      out << "\n  path does not exist";
+      return false;
+    }
+    Patterns tempPatts = patterns;
+    if (tempPatts.size() == 0)
+      tempPatts.push_back("*.*");
+
+    FileSystem::NameArena names;
+    for (auto& patt : tempPatts)
+      FileSystem::Directory::getFiles(path, patt, names);
+
+    std::vector<uint32_t> index(names.size());
+    for (size_t i = 0; i < index.size(); ++i)
+      index[i] = (uint32_t)i;
+    auto nameLess = [&names](uint32_t i, uint32_t j) {
+      return names.compare(i, j) < 0;
+    };
+    auto stemExtLess = [&names](uint32_t i, uint32_t j) {
+      return compareStemThenExt(names.c_str(i), names.length(i), names.c_str(j), names.length(j)) < 0;
+    };
+    if (order == SortOrder::name)
+      std::sort(index.begin(), index.end(), nameLess);
+    else
+      std::sort(index.begin(), index.end(), stemExtLess);
+
+    BufferedWriter writer(out);
+    for (size_t k = 0; k < index.size(); ++k)
+    {
+      if (k > 0 && names.compare(index[k - 1], index[k]) == 0)
+        continue;  // matched more than one pattern
+      writer.write("\n    ", 5);
+      writer.write(names.c_str(index[k]), names.length(index[k]));
+    }
+    writer.write("\n", 1);
+    return true;
+  }
   //----< show specified contiguous lines from a code file >---------
 
   inline bool showFileLines(
@@ -1,7 +1,7 @@
 #pragma once
 /////////////////////////////////////////////////////////////////////
 // Properties.h - provides getter and setter methods               //
-// ver 1.1                                                         //
+// ver 1.3                                                         //
 // Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018         //
 /////////////////////////////////////////////////////////////////////
 /*
@@ -23,17 +23,57 @@
 *    directly on the stored type.  However, that lets users bypass
 *    setter logic, so use it with caution.
 *
+*  BasicProperty<T, Store> has the same getter and setter syntax, but
+*  is final and non-virtual, and its storage, and so its thread safety,
+*  is chosen by a Store policy:
+*  - FinalProperty<T>    PlainStore: getter returns const T&, inlines
+*                        to a member access, not thread safe
+*  - AtomicProperty<T>   AtomicStore: std::atomic<T>, for trivially
+*                        copyable T, lock-free for small T
+*  - SnapshotProperty<T> SnapshotStore: RCU style, the getter returns
+*                        a shared_ptr<const T> snapshot, so readers
+*                        never copy T, and a setter publishes a new
+*                        value without disturbing readers holding the
+*                        old one
+*  update(f) applies f to the value atomically, retrying if another
+*  thread updated it first, for AtomicStore and SnapshotStore.
+*
+*  ObservableProperty<T> reads like SnapshotProperty<T> and also keeps
+*  a version number, bumped by every set, so a long running loop can
+*  check changedSince(seen) with one atomic load.  Subscribers are
+*  notified on an executor, e.g., a ThreadPool, or inline on the
+*  setting thread by default.  Sets that arrive before a pending
+*  notification runs are coalesced, so subscribers see the latest
+*  value once.
+*
 *  Required Files:
 *  ---------------
 *  Properties.h
 *
 *  Maintenance History:
 *  --------------------
+*  ver 1.3 : 19 Oct 2026
+*  - added ObservableProperty<T>
+*  - a subscriber may set the property it observes, without deadlock
+*  - corrected the claim that snapshot reads take no lock
+*  ver 1.2 : 19 Oct 2026
+*  - added BasicProperty<T, Store> with FinalProperty, AtomicProperty,
+*    and SnapshotProperty
 *  ver 1.1 : 30 Jan 2019
 *  - added ref()
 *  ver 1.0 : 11 Oct 2018
 *  - first release
 */
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <functional>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <cstdint>
+
 namespace Utilities
 {
   template <typename T>
@@ -70,4 +110,291 @@ namespace Utilities
   private:
     T t_;
   };
+
+  /////////////////////////////////////////////////////////////////////
+  // PlainStore - unsynchronized value, read by const reference
+
+  template <typename T>
+  class PlainStore
+  {
+  public:
+    using Read = const T&;
+    PlainStore(const T& t) : t_(t) {}
+    Read load() const { return t_; }
+    void store(const T& t) { t_ = t; }
+  private:
+    T t_;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // AtomicStore - std::atomic<T>, read and written without locks for
+  //               types the platform handles atomically
+
+  template <typename T>
+  class AtomicStore
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+      "AtomicStore<T> requires trivially copyable T, use SnapshotStore");
+  public:
+    using Read = T;
+    AtomicStore(const T& t) : t_(t) {}
+    Read load() const { return t_.load(std::memory_order_acquire); }
+    void store(const T& t) { t_.store(t, std::memory_order_release); }
+
+    template <typename F>
+    T update(F f)
+    {
+      T oldValue = t_.load(std::memory_order_relaxed);
+      T newValue = f(oldValue);
+      while (!t_.compare_exchange_weak(oldValue, newValue,
+        std::memory_order_acq_rel, std::memory_order_relaxed))
+      {
+        newValue = f(oldValue);
+      }
+      return newValue;
+    }
+  private:
+    std::atomic<T> t_;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // SnapshotStore - immutable value published through a shared_ptr
+  // - load() hands out the current snapshot, which stays valid while
+  //   the reader holds it, however many stores happen meanwhile
+  // - store() builds the new value before publishing it
+  // - load() is not lock-free: std::atomic_load of a shared_ptr takes
+  //   a lock from a small global pool on libstdc++ and MSVC, and bumps
+  //   the reference count.  The lock covers only the pointer copy, so
+  //   readers never wait on a copy or allocation of T.
+
+  template <typename T>
+  class SnapshotStore
+  {
+  public:
+    using Read = std::shared_ptr<const T>;
+    SnapshotStore(const T& t) : pT_(std::make_shared<const T>(t)) {}
+    Read load() const { return std::atomic_load(&pT_); }
+    void store(const T& t) { std::atomic_store(&pT_, std::make_shared<const T>(t)); }
+
+    template <typename F>
+    Read update(F f)
+    {
+      Read oldValue = std::atomic_load(&pT_);
+      Read newValue = std::make_shared<const T>(f(*oldValue));
+      while (!std::atomic_compare_exchange_weak(&pT_, &oldValue, newValue))
+        newValue = std::make_shared<const T>(f(*oldValue));
+      return newValue;
+    }
+  private:
+    std::shared_ptr<const T> pT_;
+  };
+
+  /////////////////////////////////////////////////////////////////////
+  // BasicProperty<T, Store> - final, non-virtual property
+
+  template <typename T, template <typename> class Store = PlainStore>
+  class BasicProperty final
+  {
+  public:
+    using Read = typename Store<T>::Read;
+
+    BasicProperty(const T& t = T()) : store_(t) {}
+    BasicProperty(const BasicProperty&) = delete;
+    BasicProperty& operator=(const BasicProperty&) = delete;
+
+    //----< setter assigns the state of t to the store >-------------
+
+    void operator()(const T& t)
+    {
+      store_.store(t);
+    }
+    //----< getter returns the store's Read type >-------------------
+
+    Read operator()() const
+    {
+      return store_.load();
+    }
+    //----< atomically replace value with f(value) >-----------------
+
+    template <typename F, typename S = Store<T>>
+    auto update(F f) -> decltype(std::declval<S&>().update(f))
+    {
+      return store_.update(f);
+    }
+  private:
+    Store<T> store_;
+  };
+
+  template <typename T>
+  using FinalProperty = BasicProperty<T, PlainStore>;
+
+  template <typename T>
+  using AtomicProperty = BasicProperty<T, AtomicStore>;
+
+  template <typename T>
+  using SnapshotProperty = BasicProperty<T, SnapshotStore>;
+
+  /////////////////////////////////////////////////////////////////////
+  // ObservableProperty<T> - versioned property with coalesced change
+  //                         notification
+  // - version() and changedSince() are a single atomic load, with no
+  //   lock.  operator()() is SnapshotStore::load(), a brief pooled
+  //   lock and a reference count increment, see above.
+  // - subscribers run one notification at a time, and must not
+  //   subscribe or unsubscribe from inside a notification
+  // - a subscriber may set the property, e.g., to clamp the value.
+  //   The delivery in progress then notifies every subscriber again
+  //   with the newer value, so it should stop setting once the value
+  //   is settled.
+
+  template <typename T>
+  class ObservableProperty final
+  {
+  public:
+    using Read = std::shared_ptr<const T>;
+    using Subscriber = std::function<void(const T& value, uint64_t version)>;
+    using Executor = std::function<void(std::function<void()>)>;
+
+    ObservableProperty(const T& t = T(), Executor executor = nullptr);
+    ObservableProperty(const ObservableProperty&) = delete;
+    ObservableProperty& operator=(const ObservableProperty&) = delete;
+
+    void operator()(const T& t);
+    Read operator()() const;
+    uint64_t version() const;
+    bool changedSince(uint64_t& seen) const;
+
+    size_t subscribe(Subscriber subscriber);
+    void unsubscribe(size_t id);
+  private:
+    // shared with queued notifications, so they may outlive the property
+    struct State
+    {
+      State(const T& t, Executor exec) : store(t), executor(exec) {}
+      void notify();
+
+      SnapshotStore<T> store;
+      std::atomic<uint64_t> version{ 0 };
+      std::atomic<bool> pending{ false };
+      Executor executor;
+      std::mutex subscribersMtx;
+      std::vector<std::pair<size_t, Subscriber>> subscribers;
+      size_t nextId = 0;
+      std::mutex deliverMtx;
+      uint64_t delivered = 0;   // version last delivered
+      std::atomic<std::thread::id> deliverer{ std::thread::id() };  // holder of deliverMtx
+    };
+    std::shared_ptr<State> pState_;
+  };
+
+  template <typename T>
+  ObservableProperty<T>::ObservableProperty(const T& t, Executor executor)
+    : pState_(std::make_shared<State>(t, executor)) {}
+
+  //----< publish t, then schedule a notification unless one is pending >
+
+  template <typename T>
+  void ObservableProperty<T>::operator()(const T& t)
+  {
+    pState_->store.store(t);
+    pState_->version.fetch_add(1, std::memory_order_release);
+    if (pState_->pending.exchange(true, std::memory_order_acq_rel))
+      return;
+    if (pState_->executor)
+    {
+      std::shared_ptr<State> pState = pState_;
+      pState_->executor([pState]() { pState->notify(); });
+    }
+    else
+      pState_->notify();
+  }
+  //----< current snapshot, at least as new as version() >-------------
+
+  template <typename T>
+  typename ObservableProperty<T>::Read ObservableProperty<T>::operator()() const
+  {
+    return pState_->store.load();
+  }
+
+  template <typename T>
+  uint64_t ObservableProperty<T>::version() const
+  {
+    return pState_->version.load(std::memory_order_acquire);
+  }
+  //----< true, updating seen, if a set happened since seen was taken >
+
+  template <typename T>
+  bool ObservableProperty<T>::changedSince(uint64_t& seen) const
+  {
+    uint64_t current = version();
+    if (current == seen)
+      return false;
+    seen = current;
+    return true;
+  }
+  //----< add subscriber, returning id for unsubscribe >---------------
+
+  template <typename T>
+  size_t ObservableProperty<T>::subscribe(Subscriber subscriber)
+  {
+    std::lock_guard<std::mutex> lock(pState_->subscribersMtx);
+    pState_->subscribers.push_back(std::make_pair(pState_->nextId, subscriber));
+    return pState_->nextId++;
+  }
+
+  template <typename T>
+  void ObservableProperty<T>::unsubscribe(size_t id)
+  {
+    std::lock_guard<std::mutex> lock(pState_->subscribersMtx);
+    auto& subs = pState_->subscribers;
+    for (auto iter = subs.begin(); iter != subs.end(); ++iter)
+    {
+      if (iter->first == id)
+      {
+        subs.erase(iter);
+        return;
+      }
+    }
+  }
+  //----< deliver latest value to every subscriber >-------------------
+  /*
+  *  pending is cleared before the value is read, so a set racing with
+  *  this delivery schedules another.  A delivery that finds nothing
+  *  newer than the last one does nothing.
+  *
+  *  A set made by a subscriber, on the delivering thread, would wait
+  *  forever for deliverMtx, so it returns at once and the loop here
+  *  delivers its newer version instead.
+  */
+  template <typename T>
+  void ObservableProperty<T>::State::notify()
+  {
+    std::thread::id self = std::this_thread::get_id();
+    if (deliverer.load(std::memory_order_acquire) == self)
+      return;
+    std::lock_guard<std::mutex> deliverLock(deliverMtx);
+    struct Owner  // releases ownership even if a subscriber throws
+    {
+      std::atomic<std::thread::id>& owner;
+      ~Owner() { owner.store(std::thread::id(), std::memory_order_release); }
+    } ownerGuard{ deliverer };
+    deliverer.store(self, std::memory_order_release);
+
+    for (;;)
+    {
+      pending.store(false, std::memory_order_release);
+      uint64_t current = version.load(std::memory_order_acquire);
+      if (current == delivered)
+        return;
+      delivered = current;
+      Read pValue = store.load();
+      std::vector<std::pair<size_t, Subscriber>> subs;
+      {
+        std::lock_guard<std::mutex> lock(subscribersMtx);
+        subs = subscribers;
+      }
+      for (auto& sub : subs)
+        sub.second(*pValue, current);
+    }
+  }
 }
@@ -1,6 +1,6 @@
 ///////////////////////////////////////////////////////////////////////
 // TestUtilities.cpp - provides single-user test harness             //
-// ver 1.0                                                           //
+// ver 1.3                                                           //
 // Language:    C++, Visual Studio 2017                              //
 // Application: Most Projects, CSE687 - Object Oriented Design       //
 // Author:      Jim Fawcett, Syracuse University, CST 4-187          //
@@ -10,6 +10,8 @@
 #include <cctype>
 #include <iostream>
 #include <functional>
+#include <thread>
+#include <chrono>
 #include "TestUtilities.h"
 #include "../StringUtilities/StringUtilities.h"
 
@@ -26,6 +28,27 @@ bool test_always_throws() {
   std::exception ex("exception\n         -- msg: this test always throws -- ");
   throw(ex);
 }
+bool test_sleeps_100ms() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  return true;
+}
+bool test_sleeps_200ms() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  return true;
+}
+bool test_prints() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  std::cout << "  test_prints: body output stays with its test\n";
+  return true;
+}
+bool test_hangs() {
+  std::this_thread::sleep_for(std::chrono::hours(1));
+  return true;
+}
+bool test_crashes() {
+  volatile int* pInt = nullptr;
+  return *pInt == 0;
+}
 
 int main()
 {
@@ -41,12 +64,67 @@ int main()
   ex.registerTest(ti1);
   ex.registerTest(ti2);
   ex.registerTest(ti3);
+  ex.registerTest(test_sleeps_200ms, "test_sleeps_200ms");
+  ex.registerTest(test_sleeps_100ms, "test_sleeps_100ms");
+  ex.registerTest(test_prints, "test_prints");
 
+  title("serial execution");
+  putline();
   bool result = ex.doTests();
   if (result == true)
     std::cout << "\n  all tests passed";
   else
     std::cout << "\n  at least one test failed";
+  ex.showSlowest(3);
+  putline();
+
+  title("parallel execution - output still in registration order");
+  putline();
+  result = ex.doTestsParallel();
+  if (result == true)
+    std::cout << "\n  all tests passed";
+  else
+    std::cout << "\n  at least one test failed";
+  ex.showSlowest(3);
+  putline();
+
+  title("micro-benchmarks with same registration API");
+  putline();
+  TestExecutive bench;
+  bench.registerTest([]() {
+    std::string str = "  trim me  ";
+    return trim(str).size() == 7;
+  }, "trim");
+  bench.registerTest([]() {
+    return split(std::string("a,b,c,d")).size() == 4;
+  }, "split");
+  BenchOptions opts;
+  opts.budgetMs = 200.0;
+  bench.doBenchmarks(opts);
+  bench.saveBaseline("bench_baseline.txt");
+  std::cout << "\n  rerun, then compare with saved baseline:\n";
+  bench.doBenchmarks(opts, std::cout);
+  bool noRegressions = bench.compareBaseline("bench_baseline.txt", 0.25);
+  std::cout << "\n  " << (noRegressions ? "no regressions" : "regressions found");
+  putline();
+
+  title("isolated execution - each test in its own process");
+  putline();
+#ifndef _WIN32
+  // only safe where isolation is real, Windows falls back to threads
+
+  ex.registerTest(test_hangs, "test_hangs");
+  ex.registerTest(test_crashes, "test_crashes");
+#endif
+  ex.registerTest(test_always_passes, "test_always_passes_again");
+  IsolationOptions isoOpts;
+  isoOpts.timeoutMs = 1000.0;
+  result = ex.doTestsIsolated(isoOpts);
+  if (result == true)
+    std::cout << "\n  all tests passed";
+  else
+    std::cout << "\n  at least one test failed";
+  ex.showSlowest(3);
 
   putline(2);
   return 0;
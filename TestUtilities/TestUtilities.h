@@ -1,7 +1,7 @@
 #pragma once
 ///////////////////////////////////////////////////////////////////////
 // TestUtilities.h - provides single-user test harness               //
-// ver 1.0                                                           //
+// ver 1.3                                                           //
 // Language:    C++, Visual Studio 2017                              //
 // Application: Most Projects, CSE687 - Object Oriented Design       //
 // Author:      Jim Fawcett, Syracuse University, CST 4-187          //
@@ -14,12 +14,61 @@
 * - TestExecutor    Executes single test in the context of a try-catch block
 * - TestExecutive   Uses TestExecutor to run a sequence of tests
 *
+* TestExecutive::doTests runs tests in registration order on the
+* calling thread.  doTestsParallel runs them on a ThreadPool, each
+* writing to its own buffer, then emits the buffers in registration
+* order, so output reads the same as a serial run.  While it runs,
+* an OutputRouter on std::cout and std::cerr sends what each test
+* body writes there into that test's buffer.  printf and writes to
+* file descriptors aren't captured.  Use it only for tests that don't
+* depend on one another or on shared state, including the format
+* state, e.g., width and precision, of std::cout.  Both
+* record each test's wall time; showSlowest(n) lists the n slowest.
+*
+* TestExecutor::benchmark and TestExecutive::doBenchmarks run the same
+* callables as micro-benchmarks.  After warmup, calls are batched so
+* each timed sample lasts at least BenchOptions::minSampleUs, then
+* samples are taken until the 95% confidence interval of the mean is
+* within targetRelCI of the mean, or the time budget is spent.  Each
+* benchmark reports mean, median, standard deviation, and ops/sec.
+* saveBaseline writes the statistics to a file, and compareBaseline
+* flags tests whose mean grew by more than both a tolerance and the
+* combined confidence intervals.
+*
+* doTestsIsolated runs tests in child processes, up to one per core,
+* each child running a shard of consecutive tests and returning
+* results and output over a pipe.  A child's stdout and stderr go to
+* a scratch file, so all a test body writes, printf included, comes
+* back with its result, in registration order.  A test that hangs is killed when
+* its shard exceeds IsolationOptions::timeoutMs per test, and one that
+* crashes takes down only its own child.  The tests of a failed shard
+* that didn't report are rerun, up to retries times, and then the
+* first of them is recorded as failed and the rest rerun without it.
+* Isolation uses fork, so on Windows doTestsIsolated falls back to
+* doTestsParallel.
+*
 * Required Files:
 * ---------------
 *   TestUtilities.h
+*   ThreadPool.h
 *
 * Maintenance History:
 * --------------------
+* ver 1.3 : 19 Oct 2026
+* - added TestExecutive::doTestsIsolated and IsolationOptions
+* - isolated children return test bodies' stdout and stderr output
+* - results still in a timed out child's pipe are read before it is
+*   judged, so tests that finished aren't blamed for the timeout
+* ver 1.2 : 19 Oct 2026
+* - added TestExecutor::benchmark, BenchOptions, and BenchStats
+* - added TestExecutive::doBenchmarks, saveBaseline, and compareBaseline
+* ver 1.1 : 19 Oct 2026
+* - added TestExecutive::doTestsParallel, per-test timing, results(),
+*   and showSlowest()
+* - doTests no longer copies each TestItem
+* - TestExecutor reports exceptions not derived from std::exception
+* - added OutputRouter, so doTestsParallel captures test bodies'
+*   std::cout and std::cerr output
 * ver 1.0 : 12 Jan 2018
 * - first release
 * - refactored from earlier Utilities.h
@@ -35,7 +84,69 @@
 */
 
 #include <vector>
+#include <string>
 #include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <cmath>
+#include <fstream>
+#include <deque>
+#include <cstdio>
+#include <climits>
+#include "../ThreadPool/ThreadPool.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+/////////////////////////////////////////////////////////////////////
+// BenchOptions and BenchStats
+// - control and results of TestExecutor::benchmark
+
+struct BenchOptions
+{
+  size_t warmups = 3;           // untimed calls before sampling
+  size_t minSamples = 10;
+  size_t maxSamples = 100000;
+  double minSampleUs = 20.0;    // batch calls until a sample takes this long
+  double budgetMs = 1000.0;     // stop sampling after this much time
+  double targetRelCI = 0.02;    // stop when CI half width < this * mean
+};
+
+struct BenchStats
+{
+  std::string name;
+  bool passed = false;          // every call returned true, none threw
+  size_t samples = 0;
+  size_t callsPerSample = 0;
+  double meanNs = 0.0;          // all times are per call
+  double medianNs = 0.0;
+  double stddevNs = 0.0;
+  double ciNs = 0.0;            // half width of 95% confidence interval
+  double opsPerSec() const { return meanNs > 0.0 ? 1.0e9 / meanNs : 0.0; }
+};
+
+/////////////////////////////////////////////////////////////////////
+// IsolationOptions
+// - control TestExecutive::doTestsIsolated
+
+struct IsolationOptions
+{
+  double timeoutMs = 60000.0;   // per test, a shard gets this * its size
+  size_t maxProcesses = 0;      // concurrent children, 0 => one per core
+  size_t shardSize = 1;         // tests run by each child
+  size_t retries = 1;           // reruns of a shard that crashes or hangs
+};
 
 /////////////////////////////////////////////////////////////////////
 // TestExecutor class
@@ -47,6 +158,10 @@ class TestExecutor
 {
 public:
   bool execute(T t, const std::string& name, std::ostream& out = std::cout);
+  BenchStats benchmark(
+    T t, const std::string& name,
+    const BenchOptions& opts = BenchOptions(), std::ostream& out = std::cout
+  );
 private:
   void check(bool result, std::ostream& out);
 };
@@ -68,8 +183,103 @@ bool TestExecutor<T>::execute(T t, const std::string& name, std::ostream& out)
     out << " -- \"" << name << "\" ";
     out << ex.what() << "\n";
   }
+  catch (...)
+  {
+    check(false, out);
+    out << " -- \"" << name << "\" unknown exception\n";
+  }
   return result;
 }
+//----< time repeated calls, sampling until stats are stable >-------
+
+template <typename T>
+BenchStats TestExecutor<T>::benchmark(
+  T t, const std::string& name, const BenchOptions& opts, std::ostream& out
+)
+{
+  using Clock = std::chrono::high_resolution_clock;
+  using Ns = std::chrono::duration<double, std::nano>;
+  BenchStats stats;
+  stats.name = name;
+  bool allTrue = true;
+  try
+  {
+    for (size_t i = 0; i < opts.warmups; ++i)
+      allTrue = t() && allTrue;
+
+    // double batch size until one batch takes at least minSampleUs
+
+    size_t batch = 1;
+    while (true)
+    {
+      Clock::time_point start = Clock::now();
+      for (size_t i = 0; i < batch; ++i)
+        allTrue = t() && allTrue;
+      double ns = Ns(Clock::now() - start).count();
+      if (ns >= 1000.0 * opts.minSampleUs || batch >= (1u << 30))
+        break;
+      batch *= 2;
+    }
+    stats.callsPerSample = batch;
+
+    std::vector<double> samples;
+    double sum = 0.0, sumSq = 0.0;
+    Clock::time_point begin = Clock::now();
+    while (samples.size() < opts.maxSamples)
+    {
+      Clock::time_point start = Clock::now();
+      for (size_t i = 0; i < batch; ++i)
+        allTrue = t() && allTrue;
+      Clock::time_point stop = Clock::now();
+      double perCall = Ns(stop - start).count() / batch;
+      samples.push_back(perCall);
+      sum += perCall;
+      sumSq += perCall * perCall;
+
+      size_t n = samples.size();
+      if (n < opts.minSamples || n < 2)
+        continue;
+      double mean = sum / n;
+      double var = (sumSq - n * mean * mean) / (n - 1);
+      double ci = 1.96 * std::sqrt(var > 0.0 ? var : 0.0) / std::sqrt((double)n);
+      double spentMs = Ns(stop - begin).count() / 1.0e6;
+      if (ci <= opts.targetRelCI * mean || spentMs >= opts.budgetMs)
+        break;
+    }
+
+    size_t n = samples.size();
+    stats.samples = n;
+    stats.meanNs = sum / n;
+    double var = n > 1 ? (sumSq - n * stats.meanNs * stats.meanNs) / (n - 1) : 0.0;
+    stats.stddevNs = std::sqrt(var > 0.0 ? var : 0.0);
+    stats.ciNs = 1.96 * stats.stddevNs / std::sqrt((double)n);
+    std::sort(samples.begin(), samples.end());
+    stats.medianNs = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+    stats.passed = allTrue;
+  }
+  catch (std::exception& ex)
+  {
+    check(false, out);
+    out << " -- \"" << name << "\" " << ex.what() << "\n";
+    return stats;
+  }
+  catch (...)
+  {
+    check(false, out);
+    out << " -- \"" << name << "\" unknown exception\n";
+    return stats;
+  }
+  check(stats.passed, out);
+  out << " -- \"" << name << "\"";
+  out << std::fixed << std::setprecision(1);
+  out << "\n      mean " << stats.meanNs << " ns +/- " << stats.ciNs
+    << ", median " << stats.medianNs << ", stddev " << stats.stddevNs
+    << ", " << std::setprecision(0) << stats.opsPerSec() << " ops/sec"
+    << ", " << stats.samples << " x " << stats.callsPerSample << " calls\n";
+  out.unsetf(std::ios::fixed);
+  out << std::setprecision(6);
+  return stats;
+}
 //----< display test results >---------------------------------------
 
 template<typename T>
@@ -81,9 +291,65 @@ void TestExecutor<T>::check(bool result, std::ostream& out)
     out << "  failed";
 }
 
+///////////////////////////////////////////////////////////////////////
+// OutputRouter class
+// - installed on a stream for its lifetime, sends each thread's writes
+//   to the buffer that thread passed to capture(), or, if none, to the
+//   stream's own buffer
+// - has no put area, so every write reaches overflow or xsputn and
+//   nothing is held back when capture changes
+
+class OutputRouter : public std::streambuf
+{
+public:
+  OutputRouter(std::ostream& stream) : stream_(stream), original_(stream.rdbuf())
+  {
+    stream_.rdbuf(this);
+  }
+  OutputRouter(const OutputRouter&) = delete;
+  OutputRouter& operator=(const OutputRouter&) = delete;
+  ~OutputRouter() { stream_.rdbuf(original_); }
+
+  static void capture(std::streambuf* pBuffer) { target() = pBuffer; }
+protected:
+  int_type overflow(int_type ch) override
+  {
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+      return traits_type::not_eof(ch);
+    if (std::streambuf* pTarget = target())
+      return pTarget->sputc(traits_type::to_char_type(ch));
+    std::lock_guard<std::mutex> lock(mtx_);
+    return original_->sputc(traits_type::to_char_type(ch));
+  }
+  std::streamsize xsputn(const char* pChars, std::streamsize count) override
+  {
+    if (std::streambuf* pTarget = target())
+      return pTarget->sputn(pChars, count);
+    std::lock_guard<std::mutex> lock(mtx_);
+    return original_->sputn(pChars, count);
+  }
+  int sync() override
+  {
+    if (std::streambuf* pTarget = target())
+      return pTarget->pubsync();
+    std::lock_guard<std::mutex> lock(mtx_);
+    return original_->pubsync();
+  }
+private:
+  static std::streambuf*& target()
+  {
+    thread_local std::streambuf* pTarget = nullptr;
+    return pTarget;
+  }
+  std::ostream& stream_;
+  std::streambuf* original_;
+  std::mutex mtx_;
+};
+
 ///////////////////////////////////////////////////////////////////////
 // TestExecutive class
 // - executes a sequence of tests with the help of TestExecutor
+// - records pass/fail and elapsed time for each test
 
 class TestExecutive
 {
@@ -94,12 +360,54 @@ public:
     std::string testName;
   };
   using Tests = std::vector<TestItem>;
+  struct TestResult
+  {
+    std::string testName;
+    bool passed;
+    double elapsedMs;
+  };
+  using Results = std::vector<TestResult>;
+  using BenchResults = std::vector<BenchStats>;
 
-  bool doTests();
+  bool doTests(std::ostream& out = std::cout);
+  bool doTestsParallel(size_t numThreads = 0, std::ostream& out = std::cout);
+  bool doTestsIsolated(const IsolationOptions& opts = IsolationOptions(), std::ostream& out = std::cout);
   void registerTest(Test t, const std::string& testName);
   void registerTest(TestItem ts);
+  const Results& results() const;
+  void showSlowest(size_t n = 5, std::ostream& out = std::cout) const;
+
+  bool doBenchmarks(const BenchOptions& opts = BenchOptions(), std::ostream& out = std::cout);
+  const BenchResults& benchResults() const;
+  bool saveBaseline(const std::string& fileSpec) const;
+  bool compareBaseline(
+    const std::string& fileSpec, double tolerance = 0.05, std::ostream& out = std::cout
+  ) const;
 private:
+  bool runTest(const TestItem& item, TestResult& result, std::ostream& out);
+  bool allPassed() const;
+#ifndef _WIN32
+  struct Shard
+  {
+    std::vector<size_t> tests;  // indices into tests_
+    size_t attempt;
+  };
+  struct Child
+  {
+    pid_t pid;
+    int fd;                     // read end of child's pipe
+    Shard shard;
+    std::chrono::steady_clock::time_point start;
+    std::string data;           // records received so far
+  };
+  bool forkShard(const Shard& shard, Child& child);
+  void runShardInChild(const Shard& shard, int fd);
+  static size_t parseRecords(const std::string& data, std::vector<size_t>& indices,
+    std::vector<bool>& passed, std::vector<double>& elapsed, std::vector<std::string>& outputs);
+#endif
   Tests tests_;
+  Results results_;
+  BenchResults benchResults_;
 };
 
 inline void TestExecutive::registerTest(Test t, const std::string& testName)
@@ -113,17 +421,477 @@ inline void TestExecutive::registerTest(TestItem ts)
   tests_.push_back(ts);
 }
 
-inline bool TestExecutive::doTests()
+inline const TestExecutive::Results& TestExecutive::results() const
+{
+  return results_;
+}
+//----< run one test, recording its result and wall time >-----------
+/*
+*  TestExecutor<const Test&> takes the test by reference, so the
+*  std::function isn't copied for each execution.
+*/
+inline bool TestExecutive::runTest(const TestItem& item, TestResult& result, std::ostream& out)
+{
+  using Clock = std::chrono::high_resolution_clock;
+  TestExecutor<const Test&> tester;
+  Clock::time_point start = Clock::now();
+  bool passed = tester.execute(item.test, item.testName, out);
+  std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+  result = TestResult{ item.testName, passed, elapsed.count() };
+  return passed;
+}
+
+inline bool TestExecutive::allPassed() const
+{
+  for (auto& result : results_)
+  {
+    if (!result.passed)
+      return false;
+  }
+  return true;
+}
+//----< run tests in registration order on this thread >-------------
+
+inline bool TestExecutive::doTests(std::ostream& out)
+{
+  results_.resize(tests_.size());
+  for (size_t i = 0; i < tests_.size(); ++i)
+    runTest(tests_[i], results_[i], out);
+  return allPassed();
+}
+//----< run tests on a thread pool, output in registration order >---
+/*
+*  Each test, and what its body writes to std::cout and std::cerr,
+*  goes to its own buffer.  A buffer is written to out as soon as it
+*  and all the buffers before it are complete, so a long suite shows
+*  progress while it runs.
+*/
+inline bool TestExecutive::doTestsParallel(size_t numThreads, std::ostream& out)
+{
+  results_.resize(tests_.size());
+  std::vector<std::ostringstream> buffers(tests_.size());
+  std::vector<bool> finished(tests_.size(), false);
+  std::mutex mtx;
+  size_t nextToEmit = 0;
+
+  OutputRouter coutRouter(std::cout);
+  OutputRouter cerrRouter(std::cerr);
+  Utilities::ThreadPool pool(numThreads);   // joined before routers go
+  for (size_t i = 0; i < tests_.size(); ++i)
+  {
+    pool.submit([this, i, &buffers, &finished, &mtx, &nextToEmit, &out]() {
+      OutputRouter::capture(buffers[i].rdbuf());
+      runTest(tests_[i], results_[i], buffers[i]);
+      OutputRouter::capture(nullptr);       // out may be std::cout
+      std::lock_guard<std::mutex> lock(mtx);
+      finished[i] = true;
+      while (nextToEmit < finished.size() && finished[nextToEmit])
+      {
+        out << buffers[nextToEmit].str();
+        buffers[nextToEmit].str("");
+        ++nextToEmit;
+      }
+    });
+  }
+  pool.wait();
+  return allPassed();
+}
+//----< show the n tests that took longest >-------------------------
+
+inline void TestExecutive::showSlowest(size_t n, std::ostream& out) const
+{
+  Results sorted = results_;
+  std::sort(sorted.begin(), sorted.end(), [](const TestResult& r1, const TestResult& r2) {
+    return r1.elapsedMs > r2.elapsedMs;
+  });
+  if (sorted.size() > n)
+    sorted.resize(n);
+  double total = 0.0;
+  for (auto& result : results_)
+    total += result.elapsedMs;
+
+  out << "\n  slowest tests:";
+  out << std::fixed << std::setprecision(3);
+  for (auto& result : sorted)
+  {
+    out << "\n  " << std::setw(12) << result.elapsedMs << " ms  " << result.testName;
+  }
+  out << "\n  " << std::setw(12) << total << " ms  total test time";
+  out.unsetf(std::ios::fixed);
+  out << std::setprecision(6);
+}
+//----< run every registered test as a micro-benchmark >-------------
+/*
+*  Benchmarks run serially, since concurrent runs disturb each
+*  other's timing.
+*/
+inline bool TestExecutive::doBenchmarks(const BenchOptions& opts, std::ostream& out)
+{
+  TestExecutor<const Test&> tester;
+  benchResults_.clear();
+  bool result = true;
+  for (auto& item : tests_)
+  {
+    benchResults_.push_back(tester.benchmark(item.test, item.testName, opts, out));
+    if (!benchResults_.back().passed)
+      result = false;
+  }
+  return result;
+}
+
+inline const TestExecutive::BenchResults& TestExecutive::benchResults() const
+{
+  return benchResults_;
+}
+//----< write benchmark stats, one tab separated line per test >-----
+
+inline bool TestExecutive::saveBaseline(const std::string& fileSpec) const
+{
+  std::ofstream baseline(fileSpec);
+  if (!baseline.good())
+    return false;
+  baseline << std::setprecision(9);
+  for (auto& stats : benchResults_)
+  {
+    if (!stats.passed)
+      continue;
+    baseline << stats.name << "\t" << stats.meanNs << "\t" << stats.medianNs << "\t"
+      << stats.stddevNs << "\t" << stats.ciNs << "\t" << stats.samples << "\n";
+  }
+  return baseline.good();
+}
+//----< flag benchmarks that are slower than saved baseline >--------
+/*
+*  A benchmark regresses when its mean exceeds the baseline mean by
+*  more than tolerance * baseline mean and by more than the sum of
+*  the two confidence interval half widths, so noise alone doesn't
+*  fail a run.  Benchmarks missing from the baseline are reported
+*  but don't fail.
+*/
+inline bool TestExecutive::compareBaseline(
+  const std::string& fileSpec, double tolerance, std::ostream& out
+) const
 {
-  TestExecutor<Test> tester;
+  std::ifstream baseline(fileSpec);
+  if (!baseline.good())
+  {
+    out << "\n  can't open baseline " << fileSpec;
+    return false;
+  }
+  std::vector<BenchStats> saved;
+  std::string line;
+  while (std::getline(baseline, line))
+  {
+    std::istringstream fields(line);
+    BenchStats stats;
+    std::getline(fields, stats.name, '\t');
+    if (fields >> stats.meanNs >> stats.medianNs >> stats.stddevNs >> stats.ciNs >> stats.samples)
+      saved.push_back(stats);
+  }
+
   bool result = true;
-  for (auto item : tests_)
+  out << std::fixed << std::setprecision(1);
+  for (auto& curr : benchResults_)
   {
-    bool tResult = tester.execute(item.test, item.testName);
-    if (tResult == false)
+    auto iter = std::find_if(saved.begin(), saved.end(),
+      [&curr](const BenchStats& base) { return base.name == curr.name; });
+    if (iter == saved.end())
+    {
+      out << "\n  no baseline for \"" << curr.name << "\"";
+      continue;
+    }
+    double growth = curr.meanNs - iter->meanNs;
+    bool regressed = growth > tolerance * iter->meanNs && growth > curr.ciNs + iter->ciNs;
+    out << "\n  " << (regressed ? "REGRESSED" : "ok       ") << " -- \"" << curr.name << "\" "
+      << iter->meanNs << " ns -> " << curr.meanNs << " ns";
+    if (regressed)
       result = false;
   }
+  out.unsetf(std::ios::fixed);
+  out << std::setprecision(6);
   return result;
 }
+//----< run tests in child processes with timeouts >-----------------
+
+inline bool TestExecutive::doTestsIsolated(const IsolationOptions& opts, std::ostream& out)
+{
+#ifdef _WIN32
+  return doTestsParallel(opts.maxProcesses, out);
+#else
+  using Clock = std::chrono::steady_clock;
+  size_t maxProcs = opts.maxProcesses > 0 ? opts.maxProcesses : Utilities::ThreadPool::defaultThreads();
+  size_t shardSize = opts.shardSize > 0 ? opts.shardSize : 1;
+
+  results_.assign(tests_.size(), TestResult{ "", false, 0.0 });
+  std::vector<std::string> outputs(tests_.size());
+  std::vector<bool> finished(tests_.size(), false);
+  size_t nextToEmit = 0;
+
+  // record a result, then emit all output that is ready, in order
+
+  auto complete = [&](size_t i, bool passed, double elapsedMs, const std::string& output) {
+    results_[i] = TestResult{ tests_[i].testName, passed, elapsedMs };
+    outputs[i] = output;
+    finished[i] = true;
+    while (nextToEmit < finished.size() && finished[nextToEmit])
+    {
+      out << outputs[nextToEmit] << std::flush;
+      outputs[nextToEmit].clear();
+      ++nextToEmit;
+    }
+  };
+
+  std::deque<Shard> pending;
+  for (size_t i = 0; i < tests_.size(); i += shardSize)
+  {
+    Shard shard{ std::vector<size_t>(), 0 };
+    for (size_t j = i; j < i + shardSize && j < tests_.size(); ++j)
+      shard.tests.push_back(j);
+    pending.push_back(shard);
+  }
+
+  std::vector<Child> running;
+  while (!pending.empty() || !running.empty())
+  {
+    while (!pending.empty() && running.size() < maxProcs)
+    {
+      Shard shard = pending.front();
+      pending.pop_front();
+      Child child;
+      if (forkShard(shard, child))
+      {
+        running.push_back(std::move(child));
+        continue;
+      }
+      for (size_t i : shard.tests)  // can't fork, so run in process
+      {
+        std::ostringstream buffer;
+        TestResult result;
+        runTest(tests_[i], result, buffer);
+        complete(i, result.passed, result.elapsedMs, buffer.str());
+      }
+    }
+    if (running.empty())
+      continue;
+
+    // wait for output from any child, or the nearest deadline
+
+    Clock::time_point now = Clock::now();
+    double waitMs = opts.timeoutMs;
+    std::vector<pollfd> polls;
+    for (auto& child : running)
+    {
+      double limit = opts.timeoutMs * child.shard.tests.size();
+      double spent = std::chrono::duration<double, std::milli>(now - child.start).count();
+      waitMs = std::min(waitMs, std::max(0.0, limit - spent));
+      polls.push_back(pollfd{ child.fd, POLLIN, 0 });
+    }
+    ::poll(polls.data(), polls.size(), (int)std::ceil(std::min(waitMs, (double)INT_MAX)));
+
+    now = Clock::now();
+    for (size_t k = running.size(); k-- > 0; )
+    {
+      Child& child = running[k];
+      bool closed = false;
+      if (polls[k].revents & (POLLIN | POLLHUP | POLLERR))
+      {
+        char buffer[4096];
+        ssize_t count = ::read(child.fd, buffer, sizeof(buffer));
+        if (count > 0)
+          child.data.append(buffer, count);
+        else if (count == 0 || errno != EINTR)
+          closed = true;
+      }
+      double spent = std::chrono::duration<double, std::milli>(now - child.start).count();
+      bool timedOut = !closed && spent >= opts.timeoutMs * child.shard.tests.size();
+      if (!closed && !timedOut)
+        continue;
+
+      if (timedOut)
+        ::kill(child.pid, SIGKILL);
+      int status = 0;
+      ::waitpid(child.pid, &status, 0);
+
+      // records written before the kill may still be in the pipe, and
+      // a test's own child could hold the pipe open, so don't block
+
+      ::fcntl(child.fd, F_SETFL, ::fcntl(child.fd, F_GETFL) | O_NONBLOCK);
+      char buffer[4096];
+      ssize_t count;
+      while ((count = ::read(child.fd, buffer, sizeof(buffer))) > 0 || (count < 0 && errno == EINTR))
+      {
+        if (count > 0)
+          child.data.append(buffer, count);
+      }
+      ::close(child.fd);
+
+      std::vector<size_t> indices;
+      std::vector<bool> passed;
+      std::vector<double> elapsed;
+      std::vector<std::string> outs;
+      parseRecords(child.data, indices, passed, elapsed, outs);
+      for (size_t r = 0; r < indices.size(); ++r)
+        complete(indices[r], passed[r], elapsed[r], outs[r]);
+
+      std::vector<size_t> remaining;
+      for (size_t i : child.shard.tests)
+      {
+        if (std::find(indices.begin(), indices.end(), i) == indices.end())
+          remaining.push_back(i);
+      }
+      if (!remaining.empty())
+      {
+        if (child.shard.attempt < opts.retries)
+        {
+          pending.push_back(Shard{ remaining, child.shard.attempt + 1 });
+        }
+        else
+        {
+          // first unreported test is the culprit, rerun the rest without it
+
+          std::ostringstream reason;
+          if (timedOut)
+            reason << "timed out after " << (size_t)spent << " ms";
+          else if (WIFSIGNALED(status))
+            reason << "crashed with signal " << WTERMSIG(status);
+          else
+            reason << "exited with status " << WEXITSTATUS(status);
+          complete(remaining[0], false, spent,
+            "  failed -- \"" + tests_[remaining[0]].testName + "\" " + reason.str() + "\n");
+          if (remaining.size() > 1)
+            pending.push_back(Shard{ std::vector<size_t>(remaining.begin() + 1, remaining.end()), 0 });
+        }
+      }
+      running.erase(running.begin() + k);
+    }
+  }
+  return allPassed();
+#endif
+}
+
+#ifndef _WIN32
+//----< start child process running shard, false if fork fails >-----
+
+inline bool TestExecutive::forkShard(const Shard& shard, Child& child)
+{
+  int fds[2];
+  if (::pipe(fds) != 0)
+    return false;
+  std::cout.flush();  // else child would repeat buffered output
+  std::cerr.flush();
+  pid_t pid = ::fork();
+  if (pid < 0)
+  {
+    ::close(fds[0]);
+    ::close(fds[1]);
+    return false;
+  }
+  if (pid == 0)
+  {
+    ::close(fds[0]);
+    runShardInChild(shard, fds[1]);
+    std::cout.flush();  // _exit doesn't flush
+    std::cerr.flush();
+    std::fflush(nullptr);
+    ::_exit(0);
+  }
+  ::close(fds[1]);
+  child.pid = pid;
+  child.fd = fds[0];
+  child.shard = shard;
+  child.start = std::chrono::steady_clock::now();
+  return true;
+}
+//----< in child: run tests, writing one record per test to fd >-----
+/*
+*  Record format: "index passed elapsedMs outputSize\n" then output.
+*/
+/*
+*  The child's stdout and stderr are redirected to an unlinked scratch
+*  file, emptied before each test and read back after it, so what the
+*  body writes, by any means, precedes the test's result line.
+*/
+inline void TestExecutive::runShardInChild(const Shard& shard, int fd)
+{
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+  std::FILE* pCapture = std::tmpfile();
+  int captureFd = pCapture != nullptr ? ::fileno(pCapture) : -1;
+  if (captureFd >= 0 && (::dup2(captureFd, 1) < 0 || ::dup2(captureFd, 2) < 0))
+    captureFd = -1;
+
+  auto readCapture = [captureFd](std::string& output) {
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    off_t end = ::lseek(captureFd, 0, SEEK_CUR);
+    size_t size = end > 0 ? (size_t)end : 0;
+    output.resize(size);
+    size_t got = 0;
+    while (got < size)
+    {
+      ssize_t count = ::pread(captureFd, &output[got], size - got, (off_t)got);
+      if (count < 0 && errno == EINTR)
+        continue;
+      if (count <= 0)
+        break;
+      got += count;
+    }
+    output.resize(got);
+  };
 
+  for (size_t i : shard.tests)
+  {
+    if (captureFd >= 0 && ::ftruncate(captureFd, 0) == 0)
+      ::lseek(captureFd, 0, SEEK_SET);
+    std::ostringstream buffer;
+    TestResult result;
+    runTest(tests_[i], result, buffer);
+    std::string output;
+    if (captureFd >= 0)
+      readCapture(output);
+    output += buffer.str();
+    std::ostringstream record;
+    record << std::setprecision(17);
+    record << i << " " << result.passed << " " << result.elapsedMs << " " << output.size() << "\n" << output;
+    std::string bytes = record.str();
+    size_t written = 0;
+    while (written < bytes.size())
+    {
+      ssize_t count = ::write(fd, bytes.data() + written, bytes.size() - written);
+      if (count < 0 && errno == EINTR)
+        continue;
+      if (count <= 0)
+        ::_exit(1);
+      written += count;
+    }
+  }
+  ::close(fd);
+}
+//----< extract complete records from child data, return count >----
 
+inline size_t TestExecutive::parseRecords(const std::string& data, std::vector<size_t>& indices,
+  std::vector<bool>& passed, std::vector<double>& elapsed, std::vector<std::string>& outputs)
+{
+  size_t pos = 0;
+  while (pos < data.size())
+  {
+    size_t eol = data.find('\n', pos);
+    if (eol == std::string::npos)
+      break;
+    std::istringstream header(data.substr(pos, eol - pos));
+    size_t index = 0, size = 0;
+    bool pass = false;
+    double ms = 0.0;
+    if (!(header >> index >> pass >> ms >> size) || eol + 1 + size > data.size())
+      break;  // partial record from a child that died
+    indices.push_back(index);
+    passed.push_back(pass);
+    elapsed.push_back(ms);
+    outputs.push_back(data.substr(eol + 1, size));
+    pos = eol + 1 + size;
+  }
+  return indices.size();
+}
+#endif
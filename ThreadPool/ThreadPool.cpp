@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////
+// ThreadPool.cpp - fixed size pool of worker threads                //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2019                              //
+// Application: Most Projects, CSE687 - Object Oriented Design       //
+// Author:      Jim Fawcett, Syracuse University, CST 4-187          //
+//              jfawcett@twcny.rr.com                                //
+///////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+#include "../StringUtilities/StringUtilities.h"
+#include <iostream>
+#include <atomic>
+#include <stdexcept>
+#include <chrono>
+
+#ifdef TEST_THREADPOOL
+
+using namespace Utilities;
+
+int main()
+{
+  Title("Testing ThreadPool Package");
+  putline();
+
+  title("submit tasks and wait");
+  std::atomic<size_t> count(0);
+  {
+    ThreadPool pool(4);
+    std::cout << "\n  pool has " << pool.size() << " workers";
+    for (size_t i = 0; i < 100; ++i)
+      pool.submit([&count]() { ++count; });
+    pool.wait();
+    std::cout << "\n  executed " << count << " tasks";
+  }
+  putline();
+
+  title("parallelFor over vector");
+  std::vector<size_t> squares(1000);
+  parallelFor(squares.size(), [&squares](size_t i) { squares[i] = i * i; });
+  bool ok = true;
+  for (size_t i = 0; i < squares.size(); ++i)
+    if (squares[i] != i * i)
+      ok = false;
+  std::cout << "\n  squares " << (ok ? "computed correctly" : "in error");
+  putline();
+
+  title("bounded queue holds submitter back");
+  {
+    ThreadPool pool(2, 8);
+    std::atomic<size_t> running(0), done(0);
+    size_t mostWaiting = 0;
+    for (size_t i = 0; i < 200; ++i)
+    {
+      pool.submit([&running, &done]() {
+        ++running;
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        --running;
+        ++done;
+      });
+      size_t waiting = i + 1 - done - running;
+      if (waiting > mostWaiting)
+        mostWaiting = waiting;
+    }
+    pool.wait();
+    std::cout << "\n  executed " << done << " tasks, at most about " << mostWaiting
+      << " waiting with maxQueued " << pool.maxQueued();
+  }
+  putline();
+
+  title("exception thrown by task is rethrown from wait()");
+  try
+  {
+    ThreadPool pool(2);
+    pool.submit([]() { throw std::runtime_error("task failed"); });
+    pool.wait();
+    std::cout << "\n  no exception - error";
+  }
+  catch (std::exception& ex)
+  {
+    std::cout << "\n  caught: " << ex.what();
+  }
+
+  putline(2);
+  return 0;
+}
+#endif
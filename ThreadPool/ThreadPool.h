@@ -0,0 +1,237 @@
+#pragma once
+///////////////////////////////////////////////////////////////////////
+// ThreadPool.h - fixed size pool of worker threads                  //
+// ver 1.1                                                           //
+// Language:    C++, Visual Studio 2019                              //
+// Application: Most Projects, CSE687 - Object Oriented Design       //
+// Author:      Jim Fawcett, Syracuse University, CST 4-187          //
+//              jfawcett@twcny.rr.com                                //
+///////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package provides:
+* - ThreadPool        a fixed number of worker threads that dequeue and
+*                     execute tasks, i.e., callable objects void(), posted
+*                     by submit(task).  Given maxQueued, submit blocks
+*                     while that many tasks wait, so a fast producer
+*                     can't queue unbounded work, or memory.
+* - parallelFor       a function that executes f(i), for i in [0, count),
+*                     using a ThreadPool.
+*
+* Public Interface:
+* -----------------
+*   ThreadPool pool(4);              // four workers, 0 => one per core
+*   ThreadPool bounded(4, 64);       // submit blocks while 64 tasks wait
+*   pool.submit([]() { work(); });   // post task for execution
+*   pool.wait();                     // block until all posted tasks finish
+*
+*   parallelFor(items.size(), [&](size_t i) { process(items[i]); });
+*
+* Required Files:
+* ---------------
+*   ThreadPool.h
+*
+* Maintenance History:
+* --------------------
+* ver 1.1 : 19 Oct 2026
+* - added optional bound on queued tasks, maxQueued
+* ver 1.0 : 19 Oct 2026
+* - first release
+*
+* Notes:
+* ------
+* - Designed to provide all functionality in header file.
+* - Implementation file only needed for test and demo.
+* - With maxQueued, a task must not submit to its own pool, as it
+*   could block forever on a queue only workers can drain.
+* - If a task throws, the first exception is captured and rethrown
+*   from wait(). Remaining tasks still run.
+*
+* Planned Additions and Changes:
+* ------------------------------
+* - none yet
+*/
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+namespace Utilities
+{
+  /////////////////////////////////////////////////////////////////////
+  // ThreadPool class
+  // - workers block on a queue of tasks, unbounded unless
+  //   maxQueued is given, when submitters block on a full queue
+
+  class ThreadPool
+  {
+  public:
+    using Task = std::function<void()>;
+
+    ThreadPool(size_t numThreads = 0, size_t maxQueued = 0);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    void submit(Task task);
+    void wait();
+    size_t size() const;
+    size_t maxQueued() const;
+    static size_t defaultThreads();
+  private:
+    void run();
+    std::vector<std::thread> workers_;
+    std::queue<Task> tasks_;
+    std::mutex mtx_;
+    std::condition_variable taskReady_;
+    std::condition_variable spaceReady_;
+    std::condition_variable allDone_;
+    size_t pending_ = 0;       // tasks queued or executing
+    size_t maxQueued_;         // 0 => unbounded
+    bool stopping_ = false;
+    std::exception_ptr pError_;
+  };
+  //----< number of hardware threads, at least one >-------------------
+
+  inline size_t ThreadPool::defaultThreads()
+  {
+    size_t n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+  }
+  //----< start workers, numThreads == 0 uses one per core >-----------
+
+  inline ThreadPool::ThreadPool(size_t numThreads, size_t maxQueued) : maxQueued_(maxQueued)
+  {
+    if (numThreads == 0)
+      numThreads = defaultThreads();
+    for (size_t i = 0; i < numThreads; ++i)
+      workers_.push_back(std::thread(&ThreadPool::run, this));
+  }
+  //----< finish posted tasks then join workers >----------------------
+
+  inline ThreadPool::~ThreadPool()
+  {
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      allDone_.wait(lock, [this]() { return pending_ == 0; });
+      stopping_ = true;
+    }
+    taskReady_.notify_all();
+    for (auto& worker : workers_)
+      worker.join();
+  }
+  //----< post task for execution, waiting for room if bounded >-------
+
+  inline void ThreadPool::submit(Task task)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+      if (maxQueued_ > 0)
+        spaceReady_.wait(lock, [this]() { return tasks_.size() < maxQueued_; });
+      tasks_.push(std::move(task));
+      ++pending_;
+    }
+    taskReady_.notify_one();
+  }
+  //----< block until all posted tasks have completed >----------------
+
+  inline void ThreadPool::wait()
+  {
+    std::unique_lock<std::mutex> lock(mtx_);
+    allDone_.wait(lock, [this]() { return pending_ == 0; });
+    if (pError_)
+    {
+      std::exception_ptr pError = pError_;
+      pError_ = nullptr;
+      std::rethrow_exception(pError);
+    }
+  }
+  //----< number of worker threads >-----------------------------------
+
+  inline size_t ThreadPool::size() const
+  {
+    return workers_.size();
+  }
+  //----< bound on waiting tasks, 0 if unbounded >---------------------
+
+  inline size_t ThreadPool::maxQueued() const
+  {
+    return maxQueued_;
+  }
+  //----< worker thread processing >-----------------------------------
+
+  inline void ThreadPool::run()
+  {
+    while (true)
+    {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(mtx_);
+        taskReady_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty())
+          return;
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      if (maxQueued_ > 0)
+        spaceReady_.notify_one();
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!pError_)
+          pError_ = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (--pending_ == 0)
+          allDone_.notify_all();
+      }
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // parallelFor function
+  // - executes f(i) for each i in [0, count) using numThreads workers
+  // - workers claim indices in chunks so tiny work items don't
+  //   serialize on the pool's queue
+
+  template<typename F>
+  void parallelFor(size_t count, F f, size_t numThreads = 0)
+  {
+    if (numThreads == 0)
+      numThreads = ThreadPool::defaultThreads();
+    if (count == 0)
+      return;
+    if (numThreads == 1 || count == 1)
+    {
+      for (size_t i = 0; i < count; ++i)
+        f(i);
+      return;
+    }
+    if (numThreads > count)
+      numThreads = count;
+
+    ThreadPool pool(numThreads);
+    size_t chunk = count / (numThreads * 4);
+    if (chunk == 0)
+      chunk = 1;
+    for (size_t first = 0; first < count; first += chunk)
+    {
+      size_t last = first + chunk < count ? first + chunk : count;
+      pool.submit([&f, first, last]() {
+        for (size_t i = first; i < last; ++i)
+          f(i);
+      });
+    }
+    pool.wait();
+  }
+}
@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////
+// ErrorMessages.cpp - demonstrates cached system error messages   //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018         //
+/////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_ERRORMESSAGES  // only compile the following when defined
+
+#include "ErrorMessages.h"
+#include "../StringUtilities/StringUtilities.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+
+using namespace WindowsHelpers;
+using namespace Utilities;
+
+int main()
+{
+  Title("Demonstrating ErrorMessages");
+
+  title("errno and system messages");
+  std::cout << "\n  errnoMessage(ENOENT) = " << errnoMessage(ENOENT);
+  std::cout << "\n  errnoMessage(EACCES) = " << errnoMessage(EACCES);
+  std::cout << "\n  errnoMessage(99999)  = " << errnoMessage(99999);
+#ifdef _WIN32
+  std::cout << "\n  systemMessage(ERROR_ACCESS_DENIED) = " << systemMessage(ERROR_ACCESS_DENIED);
+#else
+  std::cout << "\n  systemMessage(EACCES) = " << systemMessage(EACCES);
+#endif
+  std::cout << "\n  same text each call: " << std::boolalpha
+    << (errnoMessage(EACCES) == errnoMessage(EACCES));
+  putline();
+
+  title("SystemError");
+  try
+  {
+    throw SystemError(ENOENT, "open", "/no/such/file.txt");
+  }
+  catch (std::exception& ex)
+  {
+    std::cout << "\n  " << ex.what();
+  }
+  putline();
+
+  title("error storm from four threads");
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  size_t totalChars[4] = { 0 };
+  for (size_t t = 0; t < 4; ++t)
+  {
+    threads.push_back(std::thread([&totalChars, t]() {
+      for (int i = 0; i < 1000000; ++i)
+        totalChars[t] += std::strlen(systemMessage(ErrorCode(EACCES)));
+    }));
+  }
+  for (auto& thrd : threads)
+    thrd.join();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "\n  4 million lookups in " << elapsed.count() << " sec";
+
+  std::cout << "\n\n";
+  return 0;
+}
+
+#endif
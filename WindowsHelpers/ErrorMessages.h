@@ -0,0 +1,260 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// ErrorMessages.h - portable, cached system error messages        //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package maps error codes to message text on Windows and POSIX
+* platforms:
+* - errnoMessage(code)   C runtime errno values, via strerror_s or
+*                        strerror_r
+* - systemMessage(code)  operating system codes, GetLastError values
+*                        on Windows, and errno values elsewhere, via
+*                        FormatMessage or strerror_r
+* Each code's message is formatted once, then kept in a table shared
+* by all threads, so a storm of identical errors, e.g., access denied
+* across a large tree, costs one array load per message and never
+* allocates.  Codes beyond the table are formatted into a thread local
+* buffer on each call.
+*
+* SystemError is an exception carrying a system code, the name of the
+* call that failed, and the path it failed on.  Its what() text is
+* built only when asked for.
+*
+* Public Interface:
+* -----------------
+*   const char* msg = systemMessage(lastSystemError());
+*   if (!::SetCurrentDirectoryA(path.c_str()))
+*     throw SystemError(lastSystemError(), "SetCurrentDirectoryA", path);
+*   catch (SystemError& ex) { std::cout << ex.what(); }
+*
+* Required Files:
+* ---------------
+*   ErrorMessages.h, ErrorMessages.cpp  // ErrorMessages.cpp just for testing
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <exception>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace WindowsHelpers
+{
+  using ErrorCode = unsigned long;
+
+  ErrorCode lastSystemError();
+  const char* errnoMessage(int code);
+  const char* systemMessage(ErrorCode code);
+
+  namespace ErrorText
+  {
+    const size_t maxMessage = 256;
+
+    //----< pick strerror_r's result, whichever variant libc has >-----
+
+    inline const char* strerrorResult(int result, const char* buffer)
+    {
+      return result == 0 ? buffer : nullptr;  // XSI variant
+    }
+
+    inline const char* strerrorResult(const char* result, const char*)
+    {
+      return result;                          // GNU variant
+    }
+    //----< format errno message into buffer >-------------------------
+
+    inline const char* formatErrno(int code, char* buffer, size_t size)
+    {
+#ifdef _WIN32
+      if (::strerror_s(buffer, size, code) != 0)
+        buffer[0] = '\0';
+      const char* msg = buffer;
+#else
+      buffer[0] = '\0';
+      const char* msg = strerrorResult(::strerror_r(code, buffer, size), buffer);
+#endif
+      if (msg == nullptr || msg[0] == '\0')
+      {
+        std::snprintf(buffer, size, "unknown error %d", code);
+        msg = buffer;
+      }
+      return msg;
+    }
+    //----< format OS error message into buffer >----------------------
+
+    inline const char* formatSystem(ErrorCode code, char* buffer, size_t size)
+    {
+#ifdef _WIN32
+      DWORD len = ::FormatMessageA(
+        FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
+        NULL, (DWORD)code, MAKELANGID(LANG_ENGLISH, SUBLANG_ENGLISH_US),
+        buffer, (DWORD)size, NULL
+      );
+      while (len > 0 && (buffer[len - 1] == '\n' || buffer[len - 1] == '\r' || buffer[len - 1] == '.'))
+        --len;
+      if (len == 0)
+        std::snprintf(buffer, size, "unknown error %lu", code);
+      else
+        buffer[len] = '\0';
+      return buffer;
+#else
+      return formatErrno((int)code, buffer, size);
+#endif
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // MessageTable - lock-free lookup of messages formatted once
+    // - slots are filled on first use; the mutex is taken only then
+
+    class MessageTable
+    {
+    public:
+      static const size_t numSlots = 4096;
+      using Formatter = const char* (*)(ErrorCode, char*, size_t);
+
+      MessageTable(Formatter format) : format_(format)
+      {
+        for (auto& slot : slots_)
+          slot.store(nullptr, std::memory_order_relaxed);
+      }
+      MessageTable(const MessageTable&) = delete;
+      MessageTable& operator=(const MessageTable&) = delete;
+
+      const char* lookup(ErrorCode code)
+      {
+        if (code >= numSlots)
+        {
+          thread_local char buffer[maxMessage];
+          return format_(code, buffer, maxMessage);
+        }
+        const char* msg = slots_[code].load(std::memory_order_acquire);
+        if (msg != nullptr)
+          return msg;
+        char buffer[maxMessage];
+        const char* formatted = format_(code, buffer, maxMessage);
+        std::lock_guard<std::mutex> lock(mtx_);
+        msg = slots_[code].load(std::memory_order_relaxed);
+        if (msg != nullptr)
+          return msg;                         // another thread won
+        size_t len = std::strlen(formatted);
+        std::unique_ptr<char[]> pText(new char[len + 1]);
+        std::memcpy(pText.get(), formatted, len + 1);
+        msg = pText.get();
+        texts_.push_back(std::move(pText));
+        slots_[code].store(msg, std::memory_order_release);
+        return msg;
+      }
+    private:
+      Formatter format_;
+      std::atomic<const char*> slots_[numSlots];
+      std::vector<std::unique_ptr<char[]>> texts_;
+      std::mutex mtx_;
+    };
+
+    inline const char* formatErrnoCode(ErrorCode code, char* buffer, size_t size)
+    {
+      return formatErrno((int)code, buffer, size);
+    }
+  }
+
+  //----< code of the calling thread's most recent OS failure >-------
+
+  inline ErrorCode lastSystemError()
+  {
+#ifdef _WIN32
+    return ::GetLastError();
+#else
+    return (ErrorCode)errno;
+#endif
+  }
+  //----< message for errno value, valid for the life of the process >
+
+  inline const char* errnoMessage(int code)
+  {
+    static ErrorText::MessageTable table(ErrorText::formatErrnoCode);
+    return table.lookup((ErrorCode)code);
+  }
+  //----< message for OS error code >---------------------------------
+  /*
+  *  Codes below MessageTable::numSlots return text that lives for the
+  *  life of the process.  Larger codes return a thread local buffer
+  *  that the thread's next such call overwrites.
+  */
+  inline const char* systemMessage(ErrorCode code)
+  {
+#ifdef _WIN32
+    static ErrorText::MessageTable table(ErrorText::formatSystem);
+    return table.lookup(code);
+#else
+    return errnoMessage((int)code);
+#endif
+  }
+
+  /////////////////////////////////////////////////////////////////////
+  // SystemError - exception recording what failed, and where
+
+  class SystemError : public std::exception
+  {
+  public:
+    SystemError(ErrorCode code = 0, const char* syscall = "", const std::string& path = "")
+      : code_(code), syscall_(syscall), path_(path) {}
+
+    ErrorCode code() const { return code_; }
+    const char* syscall() const { return syscall_; }
+    const std::string& path() const { return path_; }
+    const char* message() const { return code_ == 0 ? "no error" : systemMessage(code_); }
+
+    //----< "syscall(path): message", built on first request >--------
+
+    const char* what() const noexcept override
+    {
+      if (what_.empty())
+      {
+        try
+        {
+          what_ = std::string(syscall_) + "(" + path_ + "): " + message();
+        }
+        catch (...)
+        {
+          return message();
+        }
+      }
+      return what_.c_str();
+    }
+    //----< reset in place, keeping path's capacity >-----------------
+
+    void assign(ErrorCode code, const char* syscall, const std::string& path)
+    {
+      code_ = code;
+      syscall_ = syscall;
+      path_.assign(path);
+      what_.clear();
+    }
+  private:
+    ErrorCode code_;
+    const char* syscall_;   // string literal, e.g., "CreateDirectoryA"
+    std::string path_;
+    mutable std::string what_;
+  };
+}
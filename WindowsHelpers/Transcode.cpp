@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////////
+// Transcode.cpp - demonstrates UTF-8, UTF-16, UTF-32 conversions  //
+// ver 1.0                                                         //
+// Jim Fawcett, CSE687 - Object Oriented Design, Fall 2018         //
+/////////////////////////////////////////////////////////////////////
+
+#ifdef TEST_TRANSCODE  // only compile the following when defined
+
+#include "Transcode.h"
+#include "../StringUtilities/StringUtilities.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+
+using namespace WindowsHelpers;
+using namespace Utilities;
+
+void showUnits(const std::u16string& str)
+{
+  std::cout << std::hex;
+  for (char16_t unit : str)
+    std::cout << " " << std::setw(4) << std::setfill('0') << (unsigned)unit;
+  std::cout << std::dec << std::setfill(' ');
+}
+
+int main()
+{
+  Title("Demonstrating Transcode");
+
+  title("round trips");
+  std::string utf8 = "path/caf\xc3\xa9/\xe6\x97\xa5\xe6\x9c\xac/\xf0\x9f\x93\x81.txt";
+  std::u16string utf16 = utf8ToUtf16(utf8);
+  std::u32string utf32 = utf8ToUtf32(utf8);
+  std::cout << "\n  " << utf8.size() << " UTF-8 bytes, " << utf16.size()
+    << " UTF-16 units, " << utf32.size() << " code points";
+  std::cout << "\n  UTF-16:";
+  showUnits(utf16);
+  std::cout << "\n  UTF-16 -> UTF-8 matches: " << std::boolalpha << (utf16ToUtf8(utf16) == utf8);
+  std::cout << "\n  UTF-32 -> UTF-8 matches: " << (utf32ToUtf8(utf32) == utf8);
+  std::cout << "\n  wide -> UTF-8 matches:   " << (wideToUtf8(utf8ToWide(utf8)) == utf8);
+  putline();
+
+  title("invalid input is rejected");
+  std::vector<std::string> invalid = {
+    "\xc0\xaf",          // overlong '/'
+    "\xed\xa0\x80",      // encoded surrogate
+    "\xf4\x90\x80\x80",  // above U+10FFFF
+    "abc\xe6\x97",       // truncated
+    "\x80"               // stray continuation byte
+  };
+  for (auto& bad : invalid)
+    std::cout << "\n  utf16Length = " << (utf16Length(bad.data(), bad.size()) == invalidUtf ? "invalidUtf" : "??");
+  try
+  {
+    utf16ToUtf8(std::u16string(1, char16_t(0xD800)));
+  }
+  catch (std::range_error& ex)
+  {
+    std::cout << "\n  unpaired surrogate: " << ex.what();
+  }
+  putline();
+
+  title("ASCII throughput");
+  std::string ascii(64 * 1024 * 1024, 'a');
+  auto start = std::chrono::steady_clock::now();
+  std::u16string wide = utf8ToUtf16(ascii);
+  std::string back = utf16ToUtf8(wide);
+  std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+  std::cout << "\n  64 MB each way in " << seconds.count() << " sec, "
+    << 2 * 64 / 1024.0 / seconds.count() << " GB/sec"
+    << (back == ascii ? "" : " - mismatch!");
+
+  std::cout << "\n\n";
+  return 0;
+}
+
+#endif
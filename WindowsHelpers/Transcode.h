@@ -0,0 +1,449 @@
+#pragma once
+/////////////////////////////////////////////////////////////////////
+// Transcode.h - validating UTF-8, UTF-16, and UTF-32 conversions  //
+// ver 1.0                                                         //
+//-----------------------------------------------------------------//
+// Jim Fawcett (c) copyright 2026                                  //
+// All rights granted provided this copyright notice is retained   //
+//-----------------------------------------------------------------//
+// Jim Fawcett, Emeritus Teaching Professor, Syracuse University   //
+/////////////////////////////////////////////////////////////////////
+/*
+* Package Operations:
+* -------------------
+* This package converts text between UTF-8 and UTF-16 or UTF-32, on
+* any platform.  Every conversion validates its input: overlong UTF-8
+* forms, encoded surrogates, code points above U+10FFFF, truncated
+* sequences, and unpaired UTF-16 surrogates are all rejected.
+*
+* Runs of ASCII, the common case for paths and source text, are
+* converted sixteen characters at a time with SSE2 on x86 and x64,
+* and eight at a time with 64 bit word tests elsewhere.
+*
+* The length functions make one validating pass that counts output
+* units, so the string helpers allocate their result exactly once and
+* then convert into it.
+*
+* Public Interface:
+* -----------------
+*   size_t n = utf16Length(utf8, len);         // invalidUtf if not valid
+*   std::vector<char16_t> buf(n);
+*   utf8ToUtf16(utf8, len, buf.data());
+*
+*   std::u16string u16 = utf8ToUtf16(std::string("caf\xc3\xa9"));
+*   std::string u8 = utf16ToUtf8(u16);         // throws std::range_error
+*   std::wstring wide = utf8ToWide(u8);        // UTF-16 or UTF-32, per wchar_t
+*
+* Required Files:
+* ---------------
+*   Transcode.h, Transcode.cpp  // Transcode.cpp just for testing
+*
+* Maintenance History:
+* --------------------
+* ver 1.0 : 19 Oct 2026
+* - first release
+*/
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRANSCODE_SSE2
+#endif
+
+namespace WindowsHelpers
+{
+  const size_t invalidUtf = size_t(-1);
+
+  size_t utf16Length(const char* src, size_t len);
+  size_t utf32Length(const char* src, size_t len);
+  size_t utf8Length(const char16_t* src, size_t len);
+  size_t utf8Length(const char32_t* src, size_t len);
+
+  size_t utf8ToUtf16(const char* src, size_t len, char16_t* dst);
+  size_t utf8ToUtf32(const char* src, size_t len, char32_t* dst);
+  size_t utf16ToUtf8(const char16_t* src, size_t len, char* dst);
+  size_t utf32ToUtf8(const char32_t* src, size_t len, char* dst);
+
+  std::u16string utf8ToUtf16(const std::string& str);
+  std::u32string utf8ToUtf32(const std::string& str);
+  std::string utf16ToUtf8(const std::u16string& str);
+  std::string utf32ToUtf8(const std::u32string& str);
+  std::wstring utf8ToWide(const std::string& str);
+  std::string wideToUtf8(const std::wstring& wstr);
+
+  namespace Transcode
+  {
+    //----< length of ASCII prefix, up to a multiple of 16 or 8 >------
+
+    inline size_t asciiPrefix(const char* src, size_t len)
+    {
+      size_t i = 0;
+#ifdef TRANSCODE_SSE2
+      for (; i + 16 <= len; i += 16)
+      {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        if (_mm_movemask_epi8(block) != 0)
+          break;
+      }
+#else
+      for (; i + 8 <= len; i += 8)
+      {
+        uint64_t word;
+        std::memcpy(&word, src + i, 8);
+        if (word & 0x8080808080808080ull)
+          break;
+      }
+#endif
+      return i;
+    }
+    //----< widen leading ASCII chars, returning how many >------------
+    /*
+    *  Converts the same prefix asciiPrefix measures, in the same pass.
+    */
+    template <typename Unit>
+    size_t widenAscii(const char* src, size_t len, Unit* dst)
+    {
+      size_t i = 0;
+#ifdef TRANSCODE_SSE2
+      const __m128i zero = _mm_setzero_si128();
+      for (; i + 16 <= len; i += 16)
+      {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        if (_mm_movemask_epi8(block) != 0)
+          break;
+        __m128i low = _mm_unpacklo_epi8(block, zero);
+        __m128i high = _mm_unpackhi_epi8(block, zero);
+        if (sizeof(Unit) == 2)
+        {
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), low);
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), high);
+        }
+        else
+        {
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi16(low, zero));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), _mm_unpackhi_epi16(low, zero));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpacklo_epi16(high, zero));
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 12), _mm_unpackhi_epi16(high, zero));
+        }
+      }
+#else
+      for (; i + 8 <= len; i += 8)
+      {
+        uint64_t word;
+        std::memcpy(&word, src + i, 8);
+        if (word & 0x8080808080808080ull)
+          break;
+        for (size_t k = 0; k < 8; ++k)
+          dst[i + k] = Unit((unsigned char)src[i + k]);
+      }
+#endif
+      return i;
+    }
+    //----< length of ASCII prefix of 16 or 32 bit units >-------------
+
+    template <typename Unit>
+    size_t asciiPrefix(const Unit* src, size_t len)
+    {
+      size_t i = 0;
+#ifdef TRANSCODE_SSE2
+      const size_t perBlock = 32 / sizeof(Unit);  // two registers
+      const __m128i highBits = sizeof(Unit) == 2 ? _mm_set1_epi16((short)0xFF80) : _mm_set1_epi32((int)0xFFFFFF80);
+      for (; i + perBlock <= len; i += perBlock)
+      {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + perBlock / 2));
+        __m128i test = _mm_and_si128(_mm_or_si128(first, second), highBits);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(test, _mm_setzero_si128())) != 0xFFFF)
+          break;
+      }
+#else
+      for (; i < len && uint32_t(src[i]) < 0x80; ++i);
+#endif
+      return i;
+    }
+    //----< narrow leading ASCII units, returning how many >-----------
+
+    template <typename Unit>
+    size_t narrowAscii(const Unit* src, size_t len, char* dst)
+    {
+      size_t i = 0;
+#ifdef TRANSCODE_SSE2
+      const size_t perBlock = 32 / sizeof(Unit);
+      const __m128i highBits = sizeof(Unit) == 2 ? _mm_set1_epi16((short)0xFF80) : _mm_set1_epi32((int)0xFFFFFF80);
+      for (; i + perBlock <= len; i += perBlock)
+      {
+        const __m128i* pBlock = reinterpret_cast<const __m128i*>(src + i);
+        __m128i first = _mm_loadu_si128(pBlock);
+        __m128i second = _mm_loadu_si128(pBlock + 1);
+        __m128i test = _mm_and_si128(_mm_or_si128(first, second), highBits);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(test, _mm_setzero_si128())) != 0xFFFF)
+          break;
+        if (sizeof(Unit) == 2)
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(first, second));
+        else
+        {
+          __m128i words = _mm_packs_epi32(first, second);
+          _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(words, words));
+        }
+      }
+#else
+      for (; i < len && uint32_t(src[i]) < 0x80; ++i)
+        dst[i] = char(src[i]);
+#endif
+      return i;
+    }
+    //----< decode one code point at src[i], advancing i >-------------
+    /*
+    *  Returns invalidUtf, leaving i unchanged, for any sequence that
+    *  isn't the shortest encoding of a scalar value.
+    */
+    inline uint32_t decodeUtf8(const char* src, size_t len, size_t& i)
+    {
+      const unsigned char* s = reinterpret_cast<const unsigned char*>(src);
+      unsigned char lead = s[i];
+      if (lead < 0x80)
+      {
+        ++i;
+        return lead;
+      }
+      size_t count;
+      uint32_t cp;
+      unsigned char low = 0x80, high = 0xBF;  // allowed range of second byte
+      if (lead >= 0xC2 && lead <= 0xDF)
+      {
+        count = 2;
+        cp = lead & 0x1F;
+      }
+      else if (lead >= 0xE0 && lead <= 0xEF)
+      {
+        count = 3;
+        cp = lead & 0x0F;
+        if (lead == 0xE0) low = 0xA0;        // overlong
+        if (lead == 0xED) high = 0x9F;       // surrogates
+      }
+      else if (lead >= 0xF0 && lead <= 0xF4)
+      {
+        count = 4;
+        cp = lead & 0x07;
+        if (lead == 0xF0) low = 0x90;        // overlong
+        if (lead == 0xF4) high = 0x8F;       // above U+10FFFF
+      }
+      else
+        return uint32_t(invalidUtf);
+      if (i + count > len || s[i + 1] < low || s[i + 1] > high)
+        return uint32_t(invalidUtf);
+      for (size_t k = 1; k < count; ++k)
+      {
+        if ((s[i + k] & 0xC0) != 0x80)
+          return uint32_t(invalidUtf);
+        cp = (cp << 6) | (s[i + k] & 0x3F);
+      }
+      i += count;
+      return cp;
+    }
+    //----< UTF-8 to 16 or 32 bit units, counting only if dst null >---
+
+    template <typename Unit>
+    size_t fromUtf8(const char* src, size_t len, Unit* dst)
+    {
+      size_t i = 0, out = 0;
+      while (i < len)
+      {
+        size_t ascii = dst ? widenAscii(src + i, len - i, dst + out) : asciiPrefix(src + i, len - i);
+        if (ascii > 0)
+        {
+          i += ascii;
+          out += ascii;
+          if (i == len)
+            break;
+        }
+        uint32_t cp = decodeUtf8(src, len, i);
+        if (cp == uint32_t(invalidUtf))
+          return invalidUtf;
+        if (sizeof(Unit) == 2 && cp >= 0x10000)
+        {
+          if (dst)
+          {
+            dst[out] = Unit(0xD800 + ((cp - 0x10000) >> 10));
+            dst[out + 1] = Unit(0xDC00 + ((cp - 0x10000) & 0x3FF));
+          }
+          out += 2;
+        }
+        else
+        {
+          if (dst)
+            dst[out] = Unit(cp);
+          ++out;
+        }
+      }
+      return out;
+    }
+    //----< 16 or 32 bit units to UTF-8, counting only if dst null >---
+
+    template <typename Unit>
+    size_t toUtf8(const Unit* src, size_t len, char* dst)
+    {
+      size_t i = 0, out = 0;
+      while (i < len)
+      {
+        size_t ascii = dst ? narrowAscii(src + i, len - i, dst + out) : asciiPrefix(src + i, len - i);
+        if (ascii > 0)
+        {
+          i += ascii;
+          out += ascii;
+          if (i == len)
+            break;
+        }
+        uint32_t cp = uint32_t(src[i++]);
+        if (cp >= 0xD800 && cp <= 0xDFFF)
+        {
+          if (sizeof(Unit) != 2 || cp >= 0xDC00 || i == len)
+            return invalidUtf;
+          uint32_t trail = uint32_t(src[i]);
+          if (trail < 0xDC00 || trail > 0xDFFF)
+            return invalidUtf;
+          ++i;
+          cp = 0x10000 + ((cp - 0xD800) << 10) + (trail - 0xDC00);
+        }
+        else if (cp > 0x10FFFF)
+          return invalidUtf;
+        size_t count = cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+        if (dst)
+        {
+          char* p = dst + out;
+          switch (count)
+          {
+          case 1:
+            p[0] = char(cp);
+            break;
+          case 2:
+            p[0] = char(0xC0 | (cp >> 6));
+            p[1] = char(0x80 | (cp & 0x3F));
+            break;
+          case 3:
+            p[0] = char(0xE0 | (cp >> 12));
+            p[1] = char(0x80 | ((cp >> 6) & 0x3F));
+            p[2] = char(0x80 | (cp & 0x3F));
+            break;
+          default:
+            p[0] = char(0xF0 | (cp >> 18));
+            p[1] = char(0x80 | ((cp >> 12) & 0x3F));
+            p[2] = char(0x80 | ((cp >> 6) & 0x3F));
+            p[3] = char(0x80 | (cp & 0x3F));
+          }
+        }
+        out += count;
+      }
+      return out;
+    }
+    //----< size result exactly, then convert into it >----------------
+
+    template <typename Result>
+    Result decodeString(const std::string& str)
+    {
+      using Unit = typename Result::value_type;
+      size_t count = fromUtf8(str.data(), str.size(), (Unit*)nullptr);
+      if (count == invalidUtf)
+        throw std::range_error("invalid UTF-8");
+      Result result(count, Unit());
+      if (count > 0)
+        fromUtf8(str.data(), str.size(), &result[0]);
+      return result;
+    }
+
+    template <typename Unit>
+    std::string encodeString(const Unit* src, size_t len)
+    {
+      size_t count = toUtf8(src, len, (char*)nullptr);
+      if (count == invalidUtf)
+        throw std::range_error(sizeof(Unit) == 2 ? "invalid UTF-16" : "invalid UTF-32");
+      std::string result(count, '\0');
+      if (count > 0)
+        toUtf8(src, len, &result[0]);
+      return result;
+    }
+  }
+
+  //----< output units needed, or invalidUtf >------------------------
+
+  inline size_t utf16Length(const char* src, size_t len)
+  {
+    return Transcode::fromUtf8(src, len, (char16_t*)nullptr);
+  }
+
+  inline size_t utf32Length(const char* src, size_t len)
+  {
+    return Transcode::fromUtf8(src, len, (char32_t*)nullptr);
+  }
+
+  inline size_t utf8Length(const char16_t* src, size_t len)
+  {
+    return Transcode::toUtf8(src, len, (char*)nullptr);
+  }
+
+  inline size_t utf8Length(const char32_t* src, size_t len)
+  {
+    return Transcode::toUtf8(src, len, (char*)nullptr);
+  }
+  //----< convert into dst, sized by the matching length function >---
+  /*
+  *  Return the number of units written, or invalidUtf, in which case
+  *  dst holds the conversion of a valid prefix.
+  */
+  inline size_t utf8ToUtf16(const char* src, size_t len, char16_t* dst)
+  {
+    return Transcode::fromUtf8(src, len, dst);
+  }
+
+  inline size_t utf8ToUtf32(const char* src, size_t len, char32_t* dst)
+  {
+    return Transcode::fromUtf8(src, len, dst);
+  }
+
+  inline size_t utf16ToUtf8(const char16_t* src, size_t len, char* dst)
+  {
+    return Transcode::toUtf8(src, len, dst);
+  }
+
+  inline size_t utf32ToUtf8(const char32_t* src, size_t len, char* dst)
+  {
+    return Transcode::toUtf8(src, len, dst);
+  }
+  //----< string conversions, throwing std::range_error if invalid >--
+
+  inline std::u16string utf8ToUtf16(const std::string& str)
+  {
+    return Transcode::decodeString<std::u16string>(str);
+  }
+
+  inline std::u32string utf8ToUtf32(const std::string& str)
+  {
+    return Transcode::decodeString<std::u32string>(str);
+  }
+
+  inline std::string utf16ToUtf8(const std::u16string& str)
+  {
+    return Transcode::encodeString(str.data(), str.size());
+  }
+
+  inline std::string utf32ToUtf8(const std::u32string& str)
+  {
+    return Transcode::encodeString(str.data(), str.size());
+  }
+  //----< wchar_t holds UTF-16 on Windows and UTF-32 elsewhere >------
+
+  inline std::wstring utf8ToWide(const std::string& str)
+  {
+    return Transcode::decodeString<std::wstring>(str);
+  }
+
+  inline std::string wideToUtf8(const std::wstring& wstr)
+  {
+    return Transcode::encodeString(wstr.data(), wstr.size());
+  }
+}
@@ -1,6 +1,6 @@
 ///////////////////////////////////////////////////////////////////////
 // WindowsHelper.cpp - small helper functions for using Windows API  //
-// ver 1.0                                                           //
+// ver 1.2                                                           //
 //-------------------------------------------------------------------//
 // Jim Fawcett (c) copyright 2015                                    //
 // All rights granted provided this copyright notice is retained     //
@@ -24,62 +24,43 @@ using namespace WindowsHelpers;
 
 std::string WindowsHelpers::wstringToString(const std::wstring& wstr)
 {
-  std::string rtn;
-  for (auto ch : wstr)
-    rtn += static_cast<char>(ch);
-  rtn += '\0';
-  return rtn;
+  return wideToUtf8(wstr);
 }
 
 std::wstring WindowsHelpers::stringToWideString(const std::string& str)
 {
-  std::wstring rtn;
-  for (auto ch : str)
-    rtn += ch;
-  rtn += static_cast<wchar_t>('\0');
-  return rtn;
+  return utf8ToWide(str);
 }
 
-//----< get socket error message string >----------------------------
-
+//----< get socket or system error message string >-----------------
+/*
+*  Messages come from the cached table in ErrorMessages.h, so repeated
+*  errors don't call FormatMessage again.
+*/
 std::string WindowsHelpers::GetLastMsg(bool WantSocketMsg) {
 
-  // ask system what type of error occurred
-
-  DWORD errorCode;
+  ErrorCode errorCode;
   if (WantSocketMsg)
     errorCode = WSAGetLastError();
   else
     errorCode = GetLastError();
   if (errorCode == 0)
     return "no error";
-
-  // map errorCode into a system defined error string
-
-  DWORD dwFlags =
-    FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_ALLOCATE_BUFFER;
-  LPCVOID lpSource = NULL;
-  DWORD dwMessageID = errorCode;
-  DWORD dwLanguageId = MAKELANGID(LANG_ENGLISH, SUBLANG_ENGLISH_US);
-  LPSTR lpBuffer;
-  DWORD nSize = 0;
-  va_list *Arguments = NULL;
-
-  FormatMessage(
-    dwFlags, lpSource, dwMessageID, dwLanguageId,
-    (LPTSTR)&lpBuffer, nSize, Arguments
-    );
-
-  std::string _msg(lpBuffer);
-  LocalFree(lpBuffer);
-  return _msg;
+  return systemMessage(errorCode);
 }
 
 #ifdef TEST_WINDOWSHELPERS
 
+#include <iostream>
+
 int main()
 {
-
+  std::string name = "caf\xc3\xa9.txt";
+  std::wstring wideName = stringToWideString(name);
+  std::cout << "\n  " << name.size() << " UTF-8 bytes -> " << wideName.size() << " UTF-16 units";
+  std::cout << "\n  round trip matches: " << std::boolalpha << (wstringToString(wideName) == name);
+  std::cout << "\n  GetLastMsg: " << GetLastMsg(false);
+  std::cout << "\n\n";
 }
 
 #endif
@@ -2,7 +2,7 @@
 #define WINDOWSHELPERS_H
 /////////////////////////////////////////////////////////////////////
 // WindowsHelper.h - small helper functions for using Windows API  //
-// ver 1.0                                                         //
+// ver 1.2                                                         //
 //-----------------------------------------------------------------//
 // Jim Fawcett (c) copyright 2015                                  //
 // All rights granted provided this copyright notice is retained   //
@@ -19,14 +19,28 @@
 * contains three global functions that convert strings to and from
 * UTF-16, and retrieving error messages.
 *
+* The conversions are done by Transcode.h, which validates and works
+* on any platform; use it directly for UTF-32 and for converting into
+* caller's buffers.
+*
+* GetLastMsg looks up messages in ErrorMessages.h, which also works on
+* any platform and provides the SystemError exception.
+*
 * Build Process:
 * --------------
-* Required Files: WindowsHelper.h, WindowwsHelper.cpp
+* Required Files: WindowsHelper.h, WindowwsHelper.cpp, Transcode.h, ErrorMessages.h
 *
 * Build Command: devenv WindowsHelper.sln /rebuild debug
 *
 * Maintenance History:
 * --------------------
+* ver 1.2 : 19 Oct 2026
+* - GetLastMsg formats each error code once, through ErrorMessages.h,
+*   instead of calling FormatMessage with an allocated buffer each time
+* ver 1.1 : 19 Oct 2026
+* - wstringToString and stringToWideString now transcode UTF-8 to and
+*   from UTF-16, instead of truncating each code unit to a char, throw
+*   std::range_error for invalid input, and no longer append '\0'
 * ver 1.0 : 22 Feb 2016
 * - first release
 *
@@ -37,6 +51,8 @@
 
 #include <string>
 #include <vector>
+#include "Transcode.h"
+#include "ErrorMessages.h"
 
 namespace WindowsHelpers
 {